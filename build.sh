@@ -131,6 +131,14 @@ if ! command -v ninja >/dev/null 2>&1; then
     exit 1
 fi
 
+# zlib and brotli back the precompressed release output (coi build --release)
+if ! printf '#include <zlib.h>\n#include <brotli/encode.h>\n' | clang++ -E -x c++ - >/dev/null 2>&1; then
+    echo "[Coi] zlib and brotli development headers not found."
+    echo "  Ubuntu/Debian: sudo apt install zlib1g-dev libbrotli-dev"
+    echo "  macOS: brew install brotli"
+    exit 1
+fi
+
 echo "[Coi] Running Ninja..."
 ninja
 
@@ -147,7 +147,7 @@ def get_mtimes(project_dir):
     return mtimes
 
 
-def watch_files(project_dir, coi_bin, keep_cc, cc_only):
+def watch_files(project_dir, coi_bin, keep_cc, cc_only, debug):
     print(f'{DIM}  Watching for changes...{RESET}')
     last = get_mtimes(project_dir)
     
@@ -165,6 +165,7 @@ def watch_files(project_dir, coi_bin, keep_cc, cc_only):
             cmd = [coi_bin, 'build']
             if keep_cc: cmd.append('--keep-cc')
             if cc_only: cmd.append('--cc-only')
+            if debug: cmd.append('--debug')
             
             try:
                 r = subprocess.run(cmd, capture_output=True, text=True, timeout=30, cwd=project_dir)
@@ -187,7 +188,7 @@ def main():
     global hot_reload_enabled
     
     if len(sys.argv) < 3:
-        print('Usage: dev_server.py <project_dir> <coi_bin> [--no-watch] [--keep-cc] [--cc-only]')
+        print('Usage: dev_server.py <project_dir> <coi_bin> [--no-watch] [--keep-cc] [--cc-only] [--debug]')
         sys.exit(1)
     
     project_dir = sys.argv[1]
@@ -196,13 +197,14 @@ def main():
     hot_reload_enabled = '--no-watch' not in sys.argv
     keep_cc = '--keep-cc' in sys.argv
     cc_only = '--cc-only' in sys.argv
+    debug = '--debug' in sys.argv
     
     os.chdir(os.path.join(project_dir, 'dist'))
     
     if hot_reload_enabled:
         watcher = threading.Thread(
             target=watch_files,
-            args=(project_dir, coi_bin, keep_cc, cc_only),
+            args=(project_dir, coi_bin, keep_cc, cc_only, debug),
             daemon=True
         )
         watcher.start()
@@ -1,8 +1,9 @@
 #include "feature_detector.h"
 #include "ast/ast.h"
+#include "ast/codegen_state.h"
 #include <functional>
 
-// Scan view nodes for event handler attributes
+// Scan view nodes for event handler attributes and kept if/else regions
 static void scan_view_for_events(ASTNode *node, FeatureFlags &flags)
 {
     if (!node)
@@ -20,6 +21,8 @@ static void scan_view_for_events(ASTNode *node, FeatureFlags &flags)
                 flags.change = true;
             else if (attr.name == "onkeydown")
                 flags.keydown = true;
+            else if (attr.name.starts_with("on") && attr.name.find(':') != std::string::npos)
+                flags.timers = true; // debounce/throttle modifiers run on the timer queue
         }
         for (const auto &child : el->children)
         {
@@ -28,6 +31,8 @@ static void scan_view_for_events(ASTNode *node, FeatureFlags &flags)
     }
     else if (auto *viewIf = dynamic_cast<ViewIfStatement *>(node))
     {
+        if (viewIf->keep)
+            flags.kept_branches = true;
         for (const auto &child : viewIf->then_children)
             scan_view_for_events(child.get(), flags);
         for (const auto &child : viewIf->else_children)
@@ -90,6 +95,11 @@ FeatureFlags detect_features(const std::vector<Component> &components,
             {
                 flags.json = true;
             }
+            // Check for Timer.sleep pattern (awaited inside async def)
+            if (call->name == "Timer.sleep")
+            {
+                flags.timers = true;
+            }
             for (auto &arg : call->args)
                 scan_expr(arg.value.get());
         }
@@ -106,6 +116,10 @@ FeatureFlags detect_features(const std::vector<Component> &components,
             }
             scan_expr(member->object.get());
         }
+        else if (auto *await_expr = dynamic_cast<AwaitExpr *>(expr))
+        {
+            scan_expr(await_expr->operand.get());
+        }
         else if (auto *binary = dynamic_cast<BinaryOp *>(expr))
         {
             scan_expr(binary->left.get());
@@ -200,25 +214,34 @@ FeatureFlags detect_features(const std::vector<Component> &components,
     return flags;
 }
 
+// Debug builds name each dispatcher for the leak audit and occupancy report; `elements` marks
+// tables keyed by DOM element handles, which a component's view must empty when it is removed
+static std::string dispatcher_name(const char *name, bool elements = true)
+{
+    if (!g_debug_build)
+        return "";
+    return std::string("{\"") + name + "\"" + (elements ? "" : ", false") + "}";
+}
+
 // Emit global declarations for enabled features
 void emit_feature_globals(std::ostream &out, const FeatureFlags &f)
 {
     // DOM event dispatchers
     if (f.click)
     {
-        out << "Dispatcher<coi::function<void()>, 128> g_dispatcher;\n";
+        out << "Dispatcher<coi::function<void()>, 128> g_dispatcher" << dispatcher_name("click") << ";\n";
     }
     if (f.input)
     {
-        out << "Dispatcher<coi::function<void(const coi::string&)>> g_input_dispatcher;\n";
+        out << "Dispatcher<coi::function<void(const coi::string&)>> g_input_dispatcher" << dispatcher_name("input") << ";\n";
     }
     if (f.change)
     {
-        out << "Dispatcher<coi::function<void(const coi::string&)>> g_change_dispatcher;\n";
+        out << "Dispatcher<coi::function<void(const coi::string&)>> g_change_dispatcher" << dispatcher_name("change") << ";\n";
     }
     if (f.keydown)
     {
-        out << "Dispatcher<coi::function<void(int)>> g_keydown_dispatcher;\n";
+        out << "Dispatcher<coi::function<void(int)>> g_keydown_dispatcher" << dispatcher_name("keydown") << ";\n";
     }
     // Runtime features
     if (f.keyboard)
@@ -231,95 +254,195 @@ void emit_feature_globals(std::ostream &out, const FeatureFlags &f)
     }
     if (f.websocket)
     {
-        out << "Dispatcher<coi::function<void(const coi::string&)>> g_ws_message_dispatcher;\n";
-        out << "Dispatcher<coi::function<void()>> g_ws_open_dispatcher;\n";
-        out << "Dispatcher<coi::function<void()>> g_ws_close_dispatcher;\n";
-        out << "Dispatcher<coi::function<void()>> g_ws_error_dispatcher;\n";
+        out << "Dispatcher<coi::function<void(const coi::string&)>> g_ws_message_dispatcher" << dispatcher_name("ws_message", false) << ";\n";
+        out << "Dispatcher<coi::function<void()>> g_ws_open_dispatcher" << dispatcher_name("ws_open", false) << ";\n";
+        out << "Dispatcher<coi::function<void()>> g_ws_close_dispatcher" << dispatcher_name("ws_close", false) << ";\n";
+        out << "Dispatcher<coi::function<void()>> g_ws_error_dispatcher" << dispatcher_name("ws_error", false) << ";\n";
+        out << "Dispatcher<coi::function<void(const coi::string&)>> g_ws_receive_dispatcher" << dispatcher_name("ws_receive", false) << ";\n";
     }
     if (f.fetch)
     {
-        out << "Dispatcher<coi::function<void(const coi::string&)>> g_fetch_success_dispatcher;\n";
-        out << "Dispatcher<coi::function<void(const coi::string&)>> g_fetch_error_dispatcher;\n";
+        out << "Dispatcher<coi::function<void(const coi::string&)>> g_fetch_success_dispatcher" << dispatcher_name("fetch_success", false) << ";\n";
+        out << "Dispatcher<coi::function<void(const coi::string&)>> g_fetch_error_dispatcher" << dispatcher_name("fetch_error", false) << ";\n";
+    }
+    if (f.timers)
+    {
+        // Growable, so an awaited sleep is never dropped. Each timer carries the component that
+        // scheduled it, and _destroy cancels a torn-down component's timers (remove_owner).
+        out << "struct TimerQueue {\n";
+        out << "    struct Entry {\n";
+        out << "        double due;\n";
+        out << "        const void* key;\n";
+        out << "        const void* owner;\n";
+        out << "        coi::function<void(const coi::string&)> callback;\n";
+        out << "    };\n";
+        out << "    coi::vector<Entry> entries;\n";
+        out << "    double now = 0;\n";
+        out << "    void add(double ms, coi::function<void(const coi::string&)> cb, const void* owner = nullptr) { set(nullptr, ms, cb, owner); }\n";
+        out << "    void set(const void* key, double ms, coi::function<void(const coi::string&)> cb, const void* owner = nullptr) {\n";
+        out << "        if (key) {\n";
+        out << "            for (int i = 0; i < (int)entries.size(); i++) {\n";
+        out << "                if (entries[i].key == key) { entries[i].due = now + ms; entries[i].callback = cb; return; }\n";
+        out << "            }\n";
+        out << "        }\n";
+        out << "        entries.push_back(Entry{now + ms, key, owner, cb});\n";
+        out << "    }\n";
+        out << "    bool has(const void* key) {\n";
+        out << "        for (int i = 0; i < (int)entries.size(); i++) if (entries[i].key == key) return true;\n";
+        out << "        return false;\n";
+        out << "    }\n";
+        out << "    void take(int i) {\n";
+        out << "        entries[i] = entries[entries.size() - 1];\n";
+        out << "        entries.pop_back();\n";
+        out << "    }\n";
+        out << "    void remove_owner(const void* owner) {\n";
+        out << "        for (int i = 0; i < (int)entries.size();) {\n";
+        out << "            if (entries[i].owner == owner) take(i);\n";
+        out << "            else i++;\n";
+        out << "        }\n";
+        out << "    }\n";
+        out << "    void run(double time) {\n";
+        out << "        now = time;\n";
+        out << "        for (int i = 0; i < (int)entries.size();) {\n";
+        out << "            if (entries[i].due > time) { i++; continue; }\n";
+        out << "            auto cb = entries[i].callback;\n";
+        out << "            take(i);\n";
+        out << "            cb(coi::string());\n";
+        out << "        }\n";
+        out << "    }\n";
+        out << "} g_timers;\n";
     }
 }
 
-// Emit event handlers for enabled features
-void emit_feature_event_handlers(std::ostream &out, const FeatureFlags &f)
+// A polled webcc event the generated code reacts to. Actions are written against the decoded
+// target handle `_h` and payload `_value`, so live dispatch and trace replay share them.
+struct EventRoute
+{
+    std::string kind;   // __coi_trace::Kind enumerator
+    std::string type;   // webcc event struct
+    std::string handle; // field holding the target handle (empty when the event has none)
+    std::string value;  // payload field (empty when none)
+    bool text;          // payload is text (otherwise an int)
+    std::vector<std::string> actions;
+};
+
+static std::vector<EventRoute> event_routes(const FeatureFlags &f)
 {
+    std::vector<EventRoute> routes;
     // DOM events
     if (f.click)
-    {
-        out << "        } else if (e.opcode == webcc::dom::ClickEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::dom::ClickEvent>()) g_dispatcher.dispatch(evt->handle);\n";
-    }
+        routes.push_back({"Click", "webcc::dom::ClickEvent", "handle", "", false, {"g_dispatcher.dispatch(_h);"}});
     if (f.input)
-    {
-        out << "        } else if (e.opcode == webcc::dom::InputEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::dom::InputEvent>()) g_input_dispatcher.dispatch(evt->handle, coi::string(evt->value));\n";
-    }
+        routes.push_back({"Input", "webcc::dom::InputEvent", "handle", "value", true, {"g_input_dispatcher.dispatch(_h, _value);"}});
     if (f.change)
-    {
-        out << "        } else if (e.opcode == webcc::dom::ChangeEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::dom::ChangeEvent>()) g_change_dispatcher.dispatch(evt->handle, coi::string(evt->value));\n";
-    }
+        routes.push_back({"Change", "webcc::dom::ChangeEvent", "handle", "value", true, {"g_change_dispatcher.dispatch(_h, _value);"}});
     if (f.keydown)
-    {
-        out << "        } else if (e.opcode == webcc::dom::KeydownEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::dom::KeydownEvent>()) g_keydown_dispatcher.dispatch(evt->handle, evt->keycode);\n";
-    }
+        routes.push_back({"Keydown", "webcc::dom::KeydownEvent", "handle", "keycode", false, {"g_keydown_dispatcher.dispatch(_h, _value);"}});
     // Runtime features
     if (f.keyboard)
     {
-        out << "        } else if (e.opcode == webcc::input::KeyDownEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::input::KeyDownEvent>()) { if (evt->key_code >= 0 && evt->key_code < 256) g_key_state[evt->key_code] = true; }\n";
-        out << "        } else if (e.opcode == webcc::input::KeyUpEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::input::KeyUpEvent>()) { if (evt->key_code >= 0 && evt->key_code < 256) g_key_state[evt->key_code] = false; }\n";
+        routes.push_back({"KeyDown", "webcc::input::KeyDownEvent", "", "key_code", false, {"if (_value >= 0 && _value < 256) g_key_state[_value] = true;"}});
+        routes.push_back({"KeyUp", "webcc::input::KeyUpEvent", "", "key_code", false, {"if (_value >= 0 && _value < 256) g_key_state[_value] = false;"}});
     }
     if (f.router)
-    {
-        out << "        } else if (e.opcode == webcc::system::PopstateEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::system::PopstateEvent>()) { if (g_popstate_callback) g_popstate_callback(coi::string(evt->path)); }\n";
-    }
+        routes.push_back({"Popstate", "webcc::system::PopstateEvent", "", "path", true, {"if (g_popstate_callback) g_popstate_callback(_value);"}});
     if (f.websocket)
     {
-        out << "        } else if (e.opcode == webcc::websocket::MessageEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::websocket::MessageEvent>()) g_ws_message_dispatcher.dispatch(evt->handle, coi::string(evt->data));\n";
-        out << "        } else if (e.opcode == webcc::websocket::OpenEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::websocket::OpenEvent>()) g_ws_open_dispatcher.dispatch(evt->handle);\n";
-        out << "        } else if (e.opcode == webcc::websocket::CloseEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::websocket::CloseEvent>()) {\n";
-        out << "                g_ws_close_dispatcher.dispatch(evt->handle);\n";
-        out << "                g_ws_message_dispatcher.remove(evt->handle);\n";
-        out << "                g_ws_open_dispatcher.remove(evt->handle);\n";
-        out << "                g_ws_close_dispatcher.remove(evt->handle);\n";
-        out << "                g_ws_error_dispatcher.remove(evt->handle);\n";
-        out << "            }\n";
-        out << "        } else if (e.opcode == webcc::websocket::ErrorEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::websocket::ErrorEvent>()) {\n";
-        out << "                g_ws_error_dispatcher.dispatch(evt->handle);\n";
-        out << "                g_ws_message_dispatcher.remove(evt->handle);\n";
-        out << "                g_ws_open_dispatcher.remove(evt->handle);\n";
-        out << "                g_ws_close_dispatcher.remove(evt->handle);\n";
-        out << "                g_ws_error_dispatcher.remove(evt->handle);\n";
-        out << "            }\n";
+        // A closed or failed socket drops every callback registered for it
+        std::vector<std::string> forget = {
+            "g_ws_message_dispatcher.remove(_h);",
+            "g_ws_open_dispatcher.remove(_h);",
+            "g_ws_close_dispatcher.remove(_h);",
+            "g_ws_error_dispatcher.remove(_h);",
+            "g_ws_receive_dispatcher.remove(_h);",
+        };
+        routes.push_back({"WsMessage", "webcc::websocket::MessageEvent", "handle", "data", true,
+                          {"g_ws_message_dispatcher.dispatch(_h, _value);",
+                           "coi::function<void(const coi::string&)> resume;",
+                           "if (g_ws_receive_dispatcher.take(_h, resume)) resume(_value);"}});
+        routes.push_back({"WsOpen", "webcc::websocket::OpenEvent", "handle", "", false, {"g_ws_open_dispatcher.dispatch(_h);"}});
+        EventRoute close = {"WsClose", "webcc::websocket::CloseEvent", "handle", "", false, {"g_ws_close_dispatcher.dispatch(_h);"}};
+        close.actions.insert(close.actions.end(), forget.begin(), forget.end());
+        routes.push_back(close);
+        EventRoute error = {"WsError", "webcc::websocket::ErrorEvent", "handle", "", false, {"g_ws_error_dispatcher.dispatch(_h);"}};
+        error.actions.insert(error.actions.end(), forget.begin(), forget.end());
+        routes.push_back(error);
     }
     if (f.fetch)
     {
-        out << "        } else if (e.opcode == webcc::fetch::SuccessEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::fetch::SuccessEvent>()) {\n";
-        out << "                g_fetch_success_dispatcher.dispatch(evt->id, coi::string(evt->data));\n";
-        out << "                g_fetch_success_dispatcher.remove(evt->id);\n";
-        out << "                g_fetch_error_dispatcher.remove(evt->id);\n";
-        out << "            }\n";
-        out << "        } else if (e.opcode == webcc::fetch::ErrorEvent::OPCODE) {\n";
-        out << "            if (auto evt = e.as<webcc::fetch::ErrorEvent>()) {\n";
-        out << "                g_fetch_error_dispatcher.dispatch(evt->id, coi::string(evt->error));\n";
-        out << "                g_fetch_success_dispatcher.remove(evt->id);\n";
-        out << "                g_fetch_error_dispatcher.remove(evt->id);\n";
+        routes.push_back({"FetchSuccess", "webcc::fetch::SuccessEvent", "id", "data", true,
+                          {"g_fetch_success_dispatcher.dispatch(_h, _value);",
+                           "g_fetch_success_dispatcher.remove(_h);",
+                           "g_fetch_error_dispatcher.remove(_h);"}});
+        routes.push_back({"FetchError", "webcc::fetch::ErrorEvent", "id", "error", true,
+                          {"g_fetch_error_dispatcher.dispatch(_h, _value);",
+                           "g_fetch_success_dispatcher.remove(_h);",
+                           "g_fetch_error_dispatcher.remove(_h);"}});
+    }
+    return routes;
+}
+
+// Emit event handlers for enabled features (record builds also log each event to g_trace)
+void emit_feature_event_handlers(std::ostream &out, const FeatureFlags &f)
+{
+    for (const auto &route : event_routes(f))
+    {
+        out << "        } else if (e.opcode == " << route.type << "::OPCODE) {\n";
+        out << "            if (auto evt = e.as<" << route.type << ">()) {\n";
+        if (!route.handle.empty())
+            out << "                auto _h = evt->" << route.handle << ";\n";
+        if (!route.value.empty())
+        {
+            if (route.text)
+                out << "                coi::string _value(evt->" << route.value << ");\n";
+            else
+                out << "                int _value = evt->" << route.value << ";\n";
+        }
+        if (g_trace_record)
+        {
+            out << "                g_trace.event(__coi_trace::" << route.kind << ");";
+            if (!route.handle.empty())
+                out << " g_trace.handle((int32_t)_h);";
+            if (!route.value.empty())
+                out << (route.text ? " g_trace.text(_value);" : " g_trace.number(_value);");
+            out << "\n";
+        }
+        for (const auto &action : route.actions)
+            out << "                " << action << "\n";
         out << "            }\n";
     }
 }
 
+// Emit replay_events(): the same actions as dispatch_events, fed from the embedded trace
+void emit_feature_event_replay(std::ostream &out, const FeatureFlags &f)
+{
+    out << "void replay_events(uint32_t count) {\n";
+    out << "    for (uint32_t i = 0; i < count && g_replay.active(); i++) {\n";
+    out << "        switch (g_replay.byte()) {\n";
+    for (const auto &route : event_routes(f))
+    {
+        out << "        case __coi_trace::" << route.kind << ": {\n";
+        if (!route.handle.empty())
+            out << "            webcc::handle _h{g_replay.handle()};\n";
+        if (!route.value.empty())
+        {
+            if (route.text)
+                out << "            coi::string _value = g_replay.text();\n";
+            else
+                out << "            int _value = g_replay.number();\n";
+        }
+        for (const auto &action : route.actions)
+            out << "            " << action << "\n";
+        out << "            break;\n";
+        out << "        }\n";
+    }
+    out << "        default:\n";
+    out << "            g_replay.stop();\n";
+    out << "        }\n";
+    out << "    }\n";
+    out << "}\n\n";
+}
+
 // Check if the Dispatcher template is needed
 bool needs_dispatcher(const FeatureFlags &f)
 {
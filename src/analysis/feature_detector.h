@@ -22,6 +22,9 @@ struct FeatureFlags
     bool websocket = false;   // WebSocket connections
     bool fetch = false;       // HTTP fetch requests
     bool json = false;        // JSON parsing (Json.parse)
+    bool timers = false;      // Frame-driven timers (await Timer.sleep)
+    // View features
+    bool kept_branches = false; // <if keep> regions (hidden branches need the [hidden] CSS rule)
 };
 
 // Detect which features are actually used by analyzing components
@@ -34,6 +37,9 @@ void emit_feature_globals(std::ostream &out, const FeatureFlags &f);
 // Emit event handlers for enabled features
 void emit_feature_event_handlers(std::ostream &out, const FeatureFlags &f);
 
+// Emit replay_events(), which applies recorded events from g_replay (--replay builds)
+void emit_feature_event_replay(std::ostream &out, const FeatureFlags &f);
+
 // Check if the Dispatcher template is needed
 bool needs_dispatcher(const FeatureFlags &f);
 
@@ -111,6 +111,10 @@ static void collect_types_from_expr(Expression *expr, std::set<std::string> &typ
         collect_types_from_expr(ternary->true_expr.get(), types);
         collect_types_from_expr(ternary->false_expr.get(), types);
     }
+    else if (auto *await_expr = dynamic_cast<AwaitExpr *>(expr))
+    {
+        collect_types_from_expr(await_expr->operand.get(), types);
+    }
     else if (auto *postfix = dynamic_cast<PostfixOp *>(expr))
     {
         collect_types_from_expr(postfix->operand.get(), types);
@@ -227,8 +231,10 @@ std::set<std::string> get_required_headers(const std::vector<Component> &compone
         auto it = type_to_header.find(type);
         if (it != type_to_header.end())
         {
-            // Skip 'json' header - it's embedded inline when features.json is true
-            if (it->second != "json")
+            // Skip runtime types that the compiler emits inline (Json, Timer, Frame, Heap, Memory, Trace) -
+            // their intrinsic prefix looks like a namespace but has no webcc header
+            static const std::set<std::string> inline_runtime = {"json", "timer", "frame", "heap", "memory", "trace"};
+            if (!inline_runtime.count(it->second))
             {
                 headers.insert(it->second);
             }
@@ -0,0 +1,174 @@
+#include "module_graph.h"
+#include <algorithm>
+
+ModuleGraph::FileId ModuleGraph::intern(const std::string &path)
+{
+    auto [it, inserted] = ids_.try_emplace(path, static_cast<FileId>(ids_.size()));
+    if (inserted)
+    {
+        imports_.emplace_back();
+        pub_imports_.emplace_back();
+        // Bitsets are sized by file count, so a new file invalidates every row
+        closure_dirty_ = true;
+    }
+    return it->second;
+}
+
+void ModuleGraph::set_imports(const std::string &file, const std::set<std::string> &imports,
+                              const std::set<std::string> &pub_imports)
+{
+    FileId id = intern(file);
+
+    std::vector<FileId> direct;
+    for (const auto &path : imports)
+        direct.push_back(intern(path));
+    std::vector<FileId> pub;
+    for (const auto &path : pub_imports)
+        pub.push_back(intern(path));
+    std::sort(direct.begin(), direct.end());
+    std::sort(pub.begin(), pub.end());
+
+    // Re-export edges feed into other files' rows; plain imports only change this file's row
+    if (pub != pub_imports_[id])
+        closure_dirty_ = true;
+    imports_[id] = std::move(direct);
+    pub_imports_[id] = std::move(pub);
+    dirty_rows_.insert(id);
+}
+
+bool ModuleGraph::is_visible(const std::string &user, const std::string &target) const
+{
+    auto user_it = ids_.find(user);
+    auto target_it = ids_.find(target);
+    if (user_it == ids_.end() || target_it == ids_.end())
+        return false;
+
+    refresh();
+    FileId t = target_it->second;
+    return (visible_[user_it->second][t / 64] >> (t % 64)) & 1;
+}
+
+void ModuleGraph::refresh() const
+{
+    if (closure_dirty_)
+    {
+        compute_reexport_closure();
+        for (FileId id = 0; id < imports_.size(); ++id)
+            compute_visible_row(id);
+        closure_dirty_ = false;
+        dirty_rows_.clear();
+        return;
+    }
+    for (FileId id : dirty_rows_)
+        compute_visible_row(id);
+    dirty_rows_.clear();
+}
+
+void ModuleGraph::compute_reexport_closure() const
+{
+    size_t n = imports_.size();
+    words_ = (n + 63) / 64;
+
+    // Iterative Tarjan over pub edges. SCCs are completed in reverse topological order,
+    // so every successor SCC's closure is final before its predecessors are built.
+    const uint32_t unvisited = UINT32_MAX;
+    std::vector<uint32_t> index(n, unvisited), lowlink(n, 0), scc_of(n, unvisited);
+    std::vector<bool> on_stack(n, false);
+    std::vector<FileId> stack;
+    std::vector<Bitset> scc_closure;
+    uint32_t next_index = 0;
+
+    struct Frame
+    {
+        FileId node;
+        size_t edge;
+    };
+    std::vector<Frame> frames;
+
+    for (FileId root = 0; root < n; ++root)
+    {
+        if (index[root] != unvisited)
+            continue;
+        frames.push_back({root, 0});
+        index[root] = lowlink[root] = next_index++;
+        stack.push_back(root);
+        on_stack[root] = true;
+
+        while (!frames.empty())
+        {
+            Frame &frame = frames.back();
+            FileId v = frame.node;
+            if (frame.edge < pub_imports_[v].size())
+            {
+                FileId w = pub_imports_[v][frame.edge++];
+                if (index[w] == unvisited)
+                {
+                    index[w] = lowlink[w] = next_index++;
+                    stack.push_back(w);
+                    on_stack[w] = true;
+                    frames.push_back({w, 0});
+                }
+                else if (on_stack[w])
+                {
+                    lowlink[v] = std::min(lowlink[v], index[w]);
+                }
+                continue;
+            }
+
+            if (lowlink[v] == index[v])
+            {
+                uint32_t scc = static_cast<uint32_t>(scc_closure.size());
+                Bitset closure(words_, 0);
+                std::vector<FileId> members;
+                FileId w;
+                do
+                {
+                    w = stack.back();
+                    stack.pop_back();
+                    on_stack[w] = false;
+                    scc_of[w] = scc;
+                    closure[w / 64] |= uint64_t(1) << (w % 64);
+                    members.push_back(w);
+                } while (w != v);
+
+                for (FileId member : members)
+                {
+                    for (FileId succ : pub_imports_[member])
+                    {
+                        uint32_t succ_scc = scc_of[succ];
+                        if (succ_scc == scc)
+                            continue;
+                        for (size_t i = 0; i < words_; ++i)
+                            closure[i] |= scc_closure[succ_scc][i];
+                    }
+                }
+                scc_closure.push_back(std::move(closure));
+            }
+
+            frames.pop_back();
+            if (!frames.empty())
+            {
+                FileId parent = frames.back().node;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[v]);
+            }
+        }
+    }
+
+    reexports_.assign(n, Bitset());
+    for (FileId id = 0; id < n; ++id)
+        reexports_[id] = scc_closure[scc_of[id]];
+    visible_.assign(n, Bitset(words_, 0));
+}
+
+void ModuleGraph::compute_visible_row(FileId file) const
+{
+    // A file sees each direct import plus everything that import re-exports, transitively
+    Bitset &row = visible_[file];
+    std::fill(row.begin(), row.end(), 0);
+    for (FileId imported : imports_[file])
+    {
+        const Bitset &closure = reexports_[imported];
+        for (size_t i = 0; i < words_; ++i)
+            row[i] |= closure[i];
+    }
+}
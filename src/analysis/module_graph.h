@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Import graph between source files, with visibility through `pub import` re-exports.
+// File paths are interned to dense IDs. The re-export closure is computed once over the
+// strongly connected components of the pub-import graph, and each file's visible set is
+// kept as a bitset, so visibility queries are a single bit test.
+class ModuleGraph
+{
+public:
+    using FileId = uint32_t;
+
+    FileId intern(const std::string &path);
+
+    // Replace one file's imports; pub_imports must be a subset of imports.
+    // Only the closure work the change can affect is redone on the next query.
+    void set_imports(const std::string &file, const std::set<std::string> &imports,
+                     const std::set<std::string> &pub_imports);
+
+    // True if target's declarations are reachable from user: imported directly, or
+    // re-exported to it through a chain of `pub import`s
+    bool is_visible(const std::string &user, const std::string &target) const;
+
+    bool empty() const { return ids_.empty(); }
+
+private:
+    using Bitset = std::vector<uint64_t>;
+
+    void refresh() const;
+    void compute_reexport_closure() const;
+    void compute_visible_row(FileId file) const;
+
+    std::unordered_map<std::string, FileId> ids_;
+    std::vector<std::vector<FileId>> imports_;      // Direct imports per file
+    std::vector<std::vector<FileId>> pub_imports_;  // `pub import` edges per file
+
+    // Derived state, rebuilt lazily by refresh()
+    mutable size_t words_ = 0;
+    mutable bool closure_dirty_ = true;
+    mutable std::set<FileId> dirty_rows_;
+    mutable std::vector<Bitset> reexports_;  // Files reachable over pub edges, including the file itself
+    mutable std::vector<Bitset> visible_;    // Files whose declarations each file can see
+};
@@ -160,6 +160,72 @@ static std::string validate_component_args(
     return "";  // Success
 }
 
+// Check whether an expression tree contains an await
+static bool expr_contains_await(Expression *expr);
+
+// Check whether a statement tree contains an await
+static bool stmt_contains_await(Statement *stmt)
+{
+    if (!stmt)
+        return false;
+    if (auto expr_stmt = dynamic_cast<ExpressionStatement *>(stmt))
+        return expr_contains_await(expr_stmt->expression.get());
+    if (auto decl = dynamic_cast<VarDeclaration *>(stmt))
+        return expr_contains_await(decl->initializer.get());
+    if (auto assign = dynamic_cast<Assignment *>(stmt))
+        return expr_contains_await(assign->value.get());
+    if (auto idx_assign = dynamic_cast<IndexAssignment *>(stmt))
+        return expr_contains_await(idx_assign->array.get()) || expr_contains_await(idx_assign->index.get()) ||
+               expr_contains_await(idx_assign->value.get());
+    if (auto member_assign = dynamic_cast<MemberAssignment *>(stmt))
+        return expr_contains_await(member_assign->object.get()) || expr_contains_await(member_assign->value.get());
+    if (auto ret = dynamic_cast<ReturnStatement *>(stmt))
+        return expr_contains_await(ret->value.get());
+    if (auto if_stmt = dynamic_cast<IfStatement *>(stmt))
+        return expr_contains_await(if_stmt->condition.get()) || stmt_contains_await(if_stmt->then_branch.get()) ||
+               stmt_contains_await(if_stmt->else_branch.get());
+    if (auto for_range = dynamic_cast<ForRangeStatement *>(stmt))
+        return expr_contains_await(for_range->start.get()) || expr_contains_await(for_range->end.get()) ||
+               stmt_contains_await(for_range->body.get());
+    if (auto for_each = dynamic_cast<ForEachStatement *>(stmt))
+        return expr_contains_await(for_each->iterable.get()) || stmt_contains_await(for_each->body.get());
+    if (auto block = dynamic_cast<BlockStatement *>(stmt))
+    {
+        for (const auto &s : block->statements)
+            if (stmt_contains_await(s.get()))
+                return true;
+    }
+    return false;
+}
+
+static bool expr_contains_await(Expression *expr)
+{
+    if (!expr)
+        return false;
+    if (dynamic_cast<AwaitExpr *>(expr))
+        return true;
+    if (auto match = dynamic_cast<MatchExpr *>(expr))
+    {
+        if (expr_contains_await(match->subject.get()))
+            return true;
+        for (const auto &arm : match->arms)
+            if (expr_contains_await(arm.body.get()))
+                return true;
+        return false;
+    }
+    if (auto block = dynamic_cast<BlockExpr *>(expr))
+    {
+        for (const auto &s : block->statements)
+            if (stmt_contains_await(s.get()))
+                return true;
+        return false;
+    }
+    for (auto *child : expr->get_children())
+        if (expr_contains_await(child))
+            return true;
+    return false;
+}
+
 // Check if a type is a known enum type
 static bool is_enum_type(const std::string &t) {
     // Check direct match
@@ -671,6 +737,61 @@ std::string infer_expression_type(Expression *expr, const std::map<std::string,
         return infer_expression_type(last_expr_stmt->expression.get(), scope);
     }
 
+    // Await expression: fetch and socket receives resume with the response text, timers with nothing
+    if (auto await_expr = dynamic_cast<AwaitExpr *>(expr))
+    {
+        auto *call = dynamic_cast<FunctionCall *>(await_expr->operand.get());
+        std::string obj_name;
+        std::string method_name;
+        if (call)
+        {
+            size_t dot_pos = call->name.rfind('.');
+            if (dot_pos != std::string::npos)
+            {
+                obj_name = call->name.substr(0, dot_pos);
+                method_name = call->name.substr(dot_pos + 1);
+            }
+        }
+
+        if (method_name == "receive" && call->args.empty() && scope.count(obj_name) &&
+            normalize_type(scope.at(obj_name)) == "WebSocket")
+        {
+            return "string";
+        }
+
+        std::string intrinsic;
+        if (!obj_name.empty() && std::isupper(obj_name[0]))
+        {
+            auto *method_def = DefSchema::instance().lookup_method(obj_name, method_name);
+            if (method_def && method_def->mapping_type == MappingType::Intrinsic)
+            {
+                intrinsic = method_def->mapping_value;
+            }
+        }
+
+        if (intrinsic == "timer_sleep")
+        {
+            infer_expression_type(call, scope);
+            return "void";
+        }
+        if (intrinsic.starts_with("fetch_"))
+        {
+            for (const auto &arg : call->args)
+            {
+                if (arg.is_reference)
+                {
+                    ErrorHandler::type_error("Awaited '" + call->name + "' cannot take callback arguments; the await resumes with the response", await_expr->line);
+                    exit(1);
+                }
+            }
+            infer_expression_type(call, scope);
+            return "string";
+        }
+
+        ErrorHandler::type_error("'await' expects FetchRequest.get/post/patch, Timer.sleep or a WebSocket receive() call", await_expr->line);
+        exit(1);
+    }
+
     if (auto func = dynamic_cast<FunctionCall *>(expr))
     {
         std::string full_name = func->name;
@@ -1820,6 +1941,34 @@ void validate_types(const std::vector<Component> &components,
                 }
             };
 
+            // await is only valid as a top-level suspension point of an async def:
+            //   await op;  |  Type name = await op;  |  name = await op;
+            for (const auto &stmt : method.body)
+            {
+                Expression *awaited = nullptr;
+                if (auto expr_stmt = dynamic_cast<ExpressionStatement *>(stmt.get()))
+                    awaited = expr_stmt->expression.get();
+                else if (auto decl = dynamic_cast<VarDeclaration *>(stmt.get()))
+                    awaited = decl->initializer.get();
+                else if (auto assign = dynamic_cast<Assignment *>(stmt.get()))
+                    awaited = assign->value.get();
+
+                auto *await_expr = dynamic_cast<AwaitExpr *>(awaited);
+                bool nested_await = await_expr ? expr_contains_await(await_expr->operand.get()) : stmt_contains_await(stmt.get());
+                if (!method.is_async && (await_expr || nested_await))
+                {
+                    ErrorHandler::type_error("'await' can only be used inside an async def ('" + method.name + "' is not async)", stmt->line);
+                    exit(1);
+                }
+                if (nested_await)
+                {
+                    ErrorHandler::type_error("'await' in async def '" + method.name +
+                        "' must be a top-level statement, initializer or assignment value (not nested in expressions, conditions or loops)",
+                        stmt->line);
+                    exit(1);
+                }
+            }
+
             for (const auto &stmt : method.body)
             {
                 check_stmt(stmt, method_scope);
@@ -1861,6 +2010,7 @@ void validate_mutability(const std::vector<Component> &components)
                 bool is_known_var = false;
                 bool is_mutable = false;
                 bool is_param = false;
+                bool is_computed = false;
 
                 for (const auto &var : comp.state)
                 {
@@ -1868,6 +2018,7 @@ void validate_mutability(const std::vector<Component> &components)
                     {
                         is_known_var = true;
                         is_mutable = var->is_mutable;
+                        is_computed = var->is_computed;
                         break;
                     }
                 }
@@ -1893,6 +2044,11 @@ void validate_mutability(const std::vector<Component> &components)
                         throw std::runtime_error("Cannot modify parameter '" + var_name + "' in component '" + comp.name +
                                                  "': parameter is not mutable. Add 'mut' keyword to parameter declaration: mut " + var_name);
                     }
+                    else if (is_computed)
+                    {
+                        throw std::runtime_error("Cannot modify computed member '" + var_name + "' in component '" + comp.name +
+                                                 "': its value is derived from its initializer expression");
+                    }
                     else
                     {
                         throw std::runtime_error("Cannot modify '" + var_name + "' in component '" + comp.name +
@@ -1905,7 +2061,7 @@ void validate_mutability(const std::vector<Component> &components)
 }
 
 void validate_view_hierarchy(const std::vector<Component> &components,
-                             const std::map<std::string, std::set<std::string>> &file_imports)
+                             const ModuleGraph &module_graph)
 {
     // Map from qualified name (Module_Name or just Name) to component
     std::map<std::string, const Component *> component_map;
@@ -1996,13 +2152,9 @@ void validate_view_hierarchy(const std::vector<Component> &components,
                                           parent_comp->module_name == target_comp->module_name);
                 bool directly_imported = false;
                 
-                if (!file_imports.empty() && !same_file && !same_named_module)
+                if (!module_graph.empty() && !same_file && !same_named_module)
                 {
-                    auto imports_it = file_imports.find(parent_comp->source_file);
-                    if (imports_it != file_imports.end())
-                    {
-                        directly_imported = imports_it->second.count(target_comp->source_file) > 0;
-                    }
+                    directly_imported = module_graph.is_visible(parent_comp->source_file, target_comp->source_file);
                     
                     if (!directly_imported)
                     {
@@ -2188,7 +2340,33 @@ void validate_view_hierarchy(const std::vector<Component> &components,
                 // Check if this is an event handler (starts with "on")
                 bool is_event_handler = attr.name.size() > 2 && attr.name[0] == 'o' && attr.name[1] == 'n';
                 
-                if (is_event_handler)
+                size_t modifier_colon = attr.name.find(':');
+                if (is_event_handler && modifier_colon != std::string::npos)
+                {
+                    // Event modifiers: on<event>:debounce={ms} / on<event>:throttle={ms}
+                    std::string event_attr = attr.name.substr(0, modifier_colon);
+                    std::string modifier = attr.name.substr(modifier_colon + 1);
+                    if (event_attr != "onclick" && event_attr != "oninput" && event_attr != "onchange" && event_attr != "onkeydown")
+                        throw std::runtime_error("Event modifier '" + attr.name + "' is not supported on '" + event_attr + 
+                            "' at line " + std::to_string(el->line));
+                    if (modifier != "debounce" && modifier != "throttle")
+                        throw std::runtime_error("Unknown event modifier '" + modifier + "' (expected debounce or throttle) at line " + 
+                            std::to_string(el->line));
+                    bool has_handler = false;
+                    for (const auto &other : el->attributes)
+                    {
+                        if (other.name == event_attr)
+                            has_handler = true;
+                    }
+                    if (!has_handler)
+                        throw std::runtime_error("Event modifier '" + attr.name + "' requires an '" + event_attr + 
+                            "' handler on the same element at line " + std::to_string(el->line));
+                    std::string ms_type = normalize_type(infer_expression_type(attr.value.get(), scope));
+                    if (ms_type != "unknown" && !is_compatible_type("int32", ms_type))
+                        throw std::runtime_error("Event modifier '" + attr.name + "' requires an int interval in milliseconds, got '" + 
+                            display_type_name(ms_type) + "' at line " + std::to_string(el->line));
+                }
+                else if (is_event_handler)
                 {
                     // Validate event handler parameter types
                     // oninput/onchange pass a string, onkeydown passes an int (keycode)
@@ -2421,9 +2599,9 @@ void validate_view_hierarchy(const std::vector<Component> &components,
 void validate_type_imports(const std::vector<Component> &components,
                            const std::vector<std::unique_ptr<EnumDef>> &global_enums,
                            const std::vector<std::unique_ptr<DataDef>> &global_data,
-                           const std::map<std::string, std::set<std::string>> &file_imports)
+                           const ModuleGraph &module_graph)
 {
-    if (file_imports.empty()) return;  // No import tracking, skip validation
+    if (module_graph.empty()) return;  // No import tracking, skip validation
     
     // Build maps from type name to source file
     std::map<std::string, std::string> data_source_files;  // type name -> source file
@@ -2444,11 +2622,8 @@ void validate_type_imports(const std::vector<Component> &components,
         // Same file - always accessible
         if (user_file == type_source_file) return true;
         
-        // Directly imported
-        auto it = file_imports.find(user_file);
-        if (it != file_imports.end() && it->second.count(type_source_file) > 0) return true;
-        
-        return false;
+        // Directly imported (or re-exported through pub imports)
+        return module_graph.is_visible(user_file, type_source_file);
     };
     
     // Check types used in each component
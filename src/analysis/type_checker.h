@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ast/ast.h"
+#include "module_graph.h"
 #include <string>
 #include <map>
 #include <set>
@@ -35,11 +36,11 @@ void validate_mutability(const std::vector<Component> &components);
 // - Callback argument types match
 // - Import visibility (no transitive imports)
 void validate_view_hierarchy(const std::vector<Component> &components,
-                             const std::map<std::string, std::set<std::string>> &file_imports = {});
+                             const ModuleGraph &module_graph = ModuleGraph());
 
 // Validate import visibility for types:
 // - Data types and enums must be directly imported or in same file/module
 void validate_type_imports(const std::vector<Component> &components,
                            const std::vector<std::unique_ptr<EnumDef>> &global_enums,
                            const std::vector<std::unique_ptr<DataDef>> &global_data,
-                           const std::map<std::string, std::set<std::string>> &file_imports);
+                           const ModuleGraph &module_graph);
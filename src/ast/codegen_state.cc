@@ -1,7 +1,25 @@
 #include "codegen_state.h"
 
 std::set<std::string> g_ref_props;
+std::set<std::string> g_computed_members;
+std::map<std::string, std::set<std::string>> g_computed_dependents;
+std::set<std::string> g_deferred_update_methods;
 std::string g_ws_assignment_target;
+std::string g_await_resume;
+std::map<std::string, std::string> g_route_stylesheets;
+std::map<std::string, std::string> g_css_scope_names;
+
+const std::string &css_scope_name(const std::string &component)
+{
+    auto it = g_css_scope_names.find(component);
+    return it == g_css_scope_names.end() ? component : it->second;
+}
+
+bool g_debug_build = false;
+bool g_trace_record = false;
+bool g_trace_replay = false;
+std::string g_heap_allocator;
+std::vector<std::string> g_callback_tables;
 
 std::map<std::string, ComponentArrayLoopInfo> g_component_array_loops;
 std::map<std::string, ArrayLoopInfo> g_array_loops;
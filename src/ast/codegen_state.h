@@ -3,12 +3,38 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 // Shared mutable state used during component->C++ lowering.
 // Declared here and defined in codegen_state.cc so ownership is explicit.
 
 extern std::set<std::string> g_ref_props;
+// Computed members of the component being lowered (read through their cached getter)
+extern std::set<std::string> g_computed_members;
+// Variable -> computed members reading it (transitively); a statement modifying the variable
+// marks them dirty right after itself
+extern std::map<std::string, std::set<std::string>> g_computed_dependents;
+// Methods with a no-update body (_<name>_inner) that calls from other methods of the component use,
+// leaving reactive updates to the outermost entry point
+extern std::set<std::string> g_deferred_update_methods;
 extern std::string g_ws_assignment_target;
+// Resume callback for the await being lowered inside an async def (empty otherwise)
+extern std::string g_await_resume;
+// Component -> value of its coi-scope attribute when it differs from the qualified name
+extern std::map<std::string, std::string> g_css_scope_names;
+const std::string &css_scope_name(const std::string &component);
+// Route target component -> handle of its stylesheet's <link>, enabled when the route activates
+extern std::map<std::string, std::string> g_route_stylesheets;
+// Debug builds (--debug) add memory telemetry to every component
+extern bool g_debug_build;
+// --record builds log polled events to g_trace; --replay builds feed them from g_replay
+extern bool g_trace_record;
+extern bool g_trace_replay;
+// Tables outside the DOM dispatchers that hold callbacks into components (timers, fetch).
+// _destroy drops a component's entries from each, so none runs on a freed instance.
+extern std::vector<std::string> g_callback_tables;
+// Heap strategy from the app block's `allocator` (empty when webcc's allocator is used directly)
+extern std::string g_heap_allocator;
 
 struct ComponentArrayLoopInfo
 {
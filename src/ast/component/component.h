@@ -40,7 +40,7 @@ struct Component : ASTNode {
     std::unique_ptr<RouterDef> router;  // Optional router block
 
     void collect_child_components(ASTNode* node, std::map<std::string, int>& counts);
-    void collect_child_updates(ASTNode* node, std::map<std::string, std::vector<std::string>>& updates, std::map<std::string, int>& counters);
+    void collect_child_updates(ASTNode* node, std::map<std::string, std::vector<std::string>>& updates, std::map<std::string, int>& counters, bool in_if_branch = false);
     std::string to_webcc() override { static CompilerSession s; return to_webcc(s); }
     std::string to_webcc(CompilerSession& session);
 };
@@ -51,6 +51,7 @@ struct AppConfig {
     std::string title;
     std::string description;
     std::string lang = "en";
+    std::string allocator;  // Coi-managed heap strategy (empty: webcc's allocator)
 };
 
 struct EventMasks
@@ -66,10 +67,32 @@ void emit_component_router_methods(std::stringstream &ss, const Component &compo
 void emit_component_lifecycle_methods(std::stringstream &ss,
                                       CompilerSession &session,
                                       const Component &component,
-                                      const EventMasks &masks,
                                       const std::vector<IfRegion> &if_regions,
                                       int element_count,
-                                      const std::map<std::string, int> &component_members);
+                                      const std::map<std::string, int> &component_members,
+                                      const std::set<std::string> &lazy_members,
+                                      const std::vector<LoopRegion> &loop_regions);
+
+// What a branch teardown left for the caller: the child components, member references and
+// loops whose DOM nodes sat at the branch's top level and so were not removed with an ancestor
+struct BranchExposure
+{
+    std::set<std::string> components;
+    std::set<std::string> member_refs;
+    std::set<int> loops;
+};
+
+// Remove one branch of an if region from the DOM: only its top-level nodes, since everything
+// else goes with them. A nested if or loop at the top level contributes its anchor and its own
+// top-level nodes. Removals run under `guard` (empty for none).
+void emit_branch_dom_removal(std::stringstream &ss,
+                             const IfRegion &region,
+                             bool then_branch,
+                             const std::vector<IfRegion> &if_regions,
+                             const std::vector<LoopRegion> &loop_regions,
+                             const std::string &indent,
+                             const std::string &guard,
+                             BranchExposure &exposed);
 
 EventMasks compute_event_masks(const std::vector<EventHandler> &handlers);
 std::set<int> get_elements_for_event(const std::vector<EventHandler> &handlers, const std::string &event_type);
@@ -81,8 +104,21 @@ void emit_event_registration(std::stringstream &ss,
                              const std::string &mask_name,
                              const std::string &dispatcher_name,
                              const std::string &lambda_params,
-                             const std::string &call_suffix);
+                             const std::string &call_suffix,
+                             bool skip_hidden = false);
 void emit_all_event_registrations(std::stringstream &ss,
                                   int element_count,
                                   const std::vector<EventHandler> &handlers,
-                                  const EventMasks &masks);
+                                  const EventMasks &masks,
+                                  bool skip_hidden = false);
+void emit_element_event_registrations(std::stringstream &ss,
+                                      const std::vector<EventHandler> &handlers,
+                                      const std::vector<int> &element_ids,
+                                      const std::string &indent);
+void emit_element_event_removals(std::stringstream &ss,
+                                 const std::vector<EventHandler> &handlers,
+                                 const std::vector<int> &element_ids,
+                                 const std::string &indent);
+// Element dispatchers (g_dispatcher, g_input_dispatcher, ...) any element of the view registers
+// into, including loop rows and elements past the 64-bit masks
+std::set<std::string> view_element_dispatchers(const Component &component);
@@ -1,4 +1,6 @@
 #include "component.h"
+#include "../codegen_state.h"
+#include <algorithm>
 
 EventMasks compute_event_masks(const std::vector<EventHandler> &handlers)
 {
@@ -61,6 +63,42 @@ static void emit_handler_switch_cases(std::stringstream &ss,
     }
 }
 
+// Dispatcher and handler-call suffix for each event type with a mask bit
+static bool masked_event(const std::string &event_type, std::string &dispatcher, std::string &params, std::string &arg)
+{
+    if (event_type == "click")
+    {
+        dispatcher = "g_dispatcher";
+        return true;
+    }
+    if (event_type == "input" || event_type == "change")
+    {
+        dispatcher = "g_" + event_type + "_dispatcher";
+        params = "const coi::string& v";
+        arg = "v";
+        return true;
+    }
+    if (event_type == "keydown")
+    {
+        dispatcher = "g_keydown_dispatcher";
+        params = "int k";
+        arg = "k";
+        return true;
+    }
+    return false;
+}
+
+// Register one handler on its element, outside the mask loops
+static void emit_single_registration(std::stringstream &ss, const EventHandler &handler, const std::string &indent)
+{
+    std::string dispatcher, params, arg;
+    if (!masked_event(handler.event_type, dispatcher, params, arg))
+        return;
+    std::string el = "el[" + std::to_string(handler.element_id) + "]";
+    ss << indent << "if (" << el << ".is_valid()) " << dispatcher << ".set(" << el << ", [this](" << params << ") { _handler_"
+       << handler.element_id << "_" << handler.event_type << "(" << arg << "); }, this);\n";
+}
+
 void emit_event_registration(std::stringstream &ss,
                              int element_count,
                              const std::vector<EventHandler> &handlers,
@@ -68,35 +106,115 @@ void emit_event_registration(std::stringstream &ss,
                              const std::string &mask_name,
                              const std::string &dispatcher_name,
                              const std::string &lambda_params,
-                             const std::string &call_suffix)
+                             const std::string &call_suffix,
+                             bool skip_hidden)
 {
-    ss << "        for (int i = 0; i < " << element_count << "; i++) if ((" << mask_name
-       << " & (1ULL << i)) && el[i].is_valid()) " << dispatcher_name << ".set(el[i], [this, i](" << lambda_params << ") {\n";
+    // Elements of hidden <if keep> branches stay unregistered until their branch is shown
+    std::string hidden = skip_hidden ? " && !(_hidden_mask & (1ULL << i))" : "";
+    ss << "        for (int i = 0; i < " << std::min(element_count, 64) << "; i++) if ((" << mask_name
+       << " & (1ULL << i)) && el[i].is_valid()" << hidden << ") " << dispatcher_name << ".set(el[i], [this, i](" << lambda_params << ") {\n";
     ss << "            switch(i) {\n";
     emit_handler_switch_cases(ss, handlers, event_type, call_suffix);
     ss << "            }\n";
-    ss << "        });\n";
+    ss << "        }, this);\n";
 }
 
 void emit_all_event_registrations(std::stringstream &ss,
                                   int element_count,
                                   const std::vector<EventHandler> &handlers,
-                                  const EventMasks &masks)
+                                  const EventMasks &masks,
+                                  bool skip_hidden)
 {
     if (masks.click)
     {
-        emit_event_registration(ss, element_count, handlers, "click", "_click_mask", "g_dispatcher", "", "");
+        emit_event_registration(ss, element_count, handlers, "click", "_click_mask", "g_dispatcher", "", "", skip_hidden);
     }
     if (masks.input)
     {
-        emit_event_registration(ss, element_count, handlers, "input", "_input_mask", "g_input_dispatcher", "const coi::string& v", "v");
+        emit_event_registration(ss, element_count, handlers, "input", "_input_mask", "g_input_dispatcher", "const coi::string& v", "v", skip_hidden);
     }
     if (masks.change)
     {
-        emit_event_registration(ss, element_count, handlers, "change", "_change_mask", "g_change_dispatcher", "const coi::string& v", "v");
+        emit_event_registration(ss, element_count, handlers, "change", "_change_mask", "g_change_dispatcher", "const coi::string& v", "v", skip_hidden);
     }
     if (masks.keydown)
     {
-        emit_event_registration(ss, element_count, handlers, "keydown", "_keydown_mask", "g_keydown_dispatcher", "int k", "k");
+        emit_event_registration(ss, element_count, handlers, "keydown", "_keydown_mask", "g_keydown_dispatcher", "int k", "k", skip_hidden);
+    }
+    // Elements past the 64-bit masks are registered one by one
+    for (const auto &handler : handlers)
+    {
+        if (handler.element_id >= 64)
+            emit_single_registration(ss, handler, "        ");
+    }
+}
+
+// Register the handlers of just the given elements (an <if keep> branch being shown)
+void emit_element_event_registrations(std::stringstream &ss,
+                                      const std::vector<EventHandler> &handlers,
+                                      const std::vector<int> &element_ids,
+                                      const std::string &indent)
+{
+    std::set<int> ids(element_ids.begin(), element_ids.end());
+    for (const auto &handler : handlers)
+    {
+        if (ids.count(handler.element_id))
+            emit_single_registration(ss, handler, indent);
     }
 }
+
+void emit_element_event_removals(std::stringstream &ss,
+                                 const std::vector<EventHandler> &handlers,
+                                 const std::vector<int> &element_ids,
+                                 const std::string &indent)
+{
+    std::set<int> ids(element_ids.begin(), element_ids.end());
+    for (const auto &handler : handlers)
+    {
+        std::string dispatcher, params, arg;
+        if (!ids.count(handler.element_id) || !masked_event(handler.event_type, dispatcher, params, arg))
+            continue;
+        ss << indent << dispatcher << ".remove(el[" << handler.element_id << "]);\n";
+    }
+}
+
+static void collect_view_dispatchers(ASTNode *node, std::set<std::string> &dispatchers)
+{
+    if (auto *el = dynamic_cast<HTMLElement *>(node))
+    {
+        for (const auto &attr : el->attributes)
+        {
+            if (attr.name == "onclick")
+                dispatchers.insert("g_dispatcher");
+            else if (attr.name == "oninput" || attr.name == "onchange" || attr.name == "onkeydown")
+                dispatchers.insert("g_" + attr.name.substr(2) + "_dispatcher");
+        }
+        for (const auto &child : el->children)
+            collect_view_dispatchers(child.get(), dispatchers);
+    }
+    else if (auto *view_if = dynamic_cast<ViewIfStatement *>(node))
+    {
+        for (const auto &child : view_if->then_children)
+            collect_view_dispatchers(child.get(), dispatchers);
+        for (const auto &child : view_if->else_children)
+            collect_view_dispatchers(child.get(), dispatchers);
+    }
+    else if (auto *view_for = dynamic_cast<ViewForRangeStatement *>(node))
+    {
+        for (const auto &child : view_for->children)
+            collect_view_dispatchers(child.get(), dispatchers);
+    }
+    else if (auto *view_for_each = dynamic_cast<ViewForEachStatement *>(node))
+    {
+        for (const auto &child : view_for_each->children)
+            collect_view_dispatchers(child.get(), dispatchers);
+    }
+}
+
+std::set<std::string> view_element_dispatchers(const Component &component)
+{
+    std::set<std::string> dispatchers;
+    for (const auto &root : component.render_roots)
+        collect_view_dispatchers(root.get(), dispatchers);
+    return dispatchers;
+}
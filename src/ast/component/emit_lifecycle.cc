@@ -1,180 +1,162 @@
 #include "component.h"
+#include "../codegen_state.h"
 
-void emit_component_lifecycle_methods(std::stringstream &ss,
-                                      CompilerSession &session,
-                                      const Component &component,
-                                      const EventMasks &masks,
-                                      const std::vector<IfRegion> &if_regions,
-                                      int element_count,
-                                      const std::map<std::string, int> &component_members)
+void emit_branch_dom_removal(std::stringstream &ss,
+                             const IfRegion &region,
+                             bool then_branch,
+                             const std::vector<IfRegion> &if_regions,
+                             const std::vector<LoopRegion> &loop_regions,
+                             const std::string &indent,
+                             const std::string &guard,
+                             BranchExposure &exposed)
 {
-    // Destroy method
-    ss << "    void _destroy() {\n";
+    const BranchTop &top = then_branch ? region.then_top : region.else_top;
+    std::string prefix = indent + (guard.empty() ? "" : "if (" + guard + ") ");
 
-    // Collect all elements that are conditionally created in if/else regions
-    std::set<int> conditional_els;
-    for (const auto &region : if_regions)
+    for (int el_id : top.elements)
     {
-        for (int el_id : region.then_element_ids)
-            conditional_els.insert(el_id);
-        for (int el_id : region.else_element_ids)
-            conditional_els.insert(el_id);
+        ss << prefix << "g_dom_writes.remove(el[" << el_id << "]);\n";
     }
-
-    // Determine if the view has if/else regions that control root elements
-    // If so, we need to conditionally remove elements based on _if_N_state
-    std::set<int> then_els, else_els;
-    int root_if_id = -1;
-    for (const auto &region : if_regions)
+    exposed.components.insert(top.components.begin(), top.components.end());
+    exposed.member_refs.insert(top.member_refs.begin(), top.member_refs.end());
+    for (int loop_id : top.loops)
     {
-        // Check if this if region contains root-level elements (el[0] or similar low indices)
-        for (int el_id : region.then_element_ids)
+        exposed.loops.insert(loop_id);
+        for (const auto &lr : loop_regions)
         {
-            then_els.insert(el_id);
-            if (el_id == 0)
-                root_if_id = region.if_id;
-        }
-        for (int el_id : region.else_element_ids)
-        {
-            else_els.insert(el_id);
-            if (root_if_id < 0)
+            if (lr.loop_id == loop_id && lr.is_html_loop)
             {
-                // Check if first else element could be a root
-                for (int tel_id : region.then_element_ids)
-                {
-                    if (tel_id == 0)
-                    {
-                        root_if_id = region.if_id;
-                        break;
-                    }
-                }
+                std::string vec_name = "_loop_" + std::to_string(loop_id) + "_elements";
+                ss << prefix << "for (int _i = 0; _i < (int)" << vec_name << ".size(); _i++) g_dom_writes.remove("
+                   << vec_name << "[_i]);\n";
             }
         }
+        ss << prefix << "g_dom_writes.remove(_loop_" << loop_id << "_anchor);\n";
     }
+    for (int if_id : top.ifs)
+    {
+        for (const auto &nested : if_regions)
+        {
+            if (nested.if_id != if_id)
+                continue;
+            // A kept region may have both branches built, one of them hidden
+            std::string state = "_if_" + std::to_string(if_id);
+            std::string then_live = nested.keep ? state + "_then_built" : state + "_state";
+            std::string else_live = nested.keep ? state + "_else_built" : "!" + state + "_state";
+            std::string outer = guard.empty() ? "" : guard + " && ";
+            emit_branch_dom_removal(ss, nested, true, if_regions, loop_regions, indent, outer + then_live, exposed);
+            emit_branch_dom_removal(ss, nested, false, if_regions, loop_regions, indent, outer + else_live, exposed);
+            break;
+        }
+        ss << prefix << "g_dom_writes.remove(_if_" << if_id << "_anchor);\n";
+    }
+}
 
-    // If we have if/else at root level, generate conditional destroy
-    if (root_if_id >= 0 && !if_regions.empty())
+void emit_component_lifecycle_methods(std::stringstream &ss,
+                                      CompilerSession &session,
+                                      const Component &component,
+                                      const std::vector<IfRegion> &if_regions,
+                                      int element_count,
+                                      const std::map<std::string, int> &component_members,
+                                      const std::set<std::string> &lazy_members,
+                                      const std::vector<LoopRegion> &loop_regions)
+{
+    // Determine if the view has an if/else region at its root (one that creates el[0])
+    const IfRegion *root_region = nullptr;
+    for (const auto &region : if_regions)
     {
-        // Find the root if region
-        const IfRegion *root_region = nullptr;
-        for (const auto &region : if_regions)
+        for (int el_id : region.then_element_ids)
         {
-            if (region.if_id == root_if_id)
-            {
+            if (el_id == 0)
                 root_region = &region;
-                break;
-            }
         }
+    }
+    int root_if_id = root_region ? root_region->if_id : -1;
+
+    // Every handler is tagged with the instance that registered it, so one pass over each
+    // element dispatcher drops them all, whichever branch or loop registered them
+    std::string handler_removal;
+    for (const auto &dispatcher : view_element_dispatchers(component))
+        handler_removal += "        " + dispatcher + ".remove_owner(this);\n";
+
+    // Removing the view's top-level nodes takes every nested node with it. With a root if/else
+    // those are the live branch's top-level nodes and the anchor; otherwise el[0] holds the view.
+    BranchExposure root_exposed;
+    std::stringstream dom_removal;
+    if (root_region)
+    {
+        dom_removal << "        if (!skip_dom_removal) {\n";
+        dom_removal << "            if (_if_" << root_if_id << "_state) {\n";
+        emit_branch_dom_removal(dom_removal, *root_region, true, if_regions, loop_regions, "                ", "",
+                                root_exposed);
+        dom_removal << "            } else {\n";
+        emit_branch_dom_removal(dom_removal, *root_region, false, if_regions, loop_regions, "                ", "",
+                                root_exposed);
+        dom_removal << "            }\n";
+        dom_removal << "            g_dom_writes.remove(_if_" << root_if_id << "_anchor);\n";
+        dom_removal << "        }\n";
+    }
+    else if (element_count > 0)
+    {
+        dom_removal << "        if (!skip_dom_removal) g_dom_writes.remove(el[0]);\n";
+    }
 
+    // A child whose root sits inside a node removed above skips its own DOM removal; one at the
+    // view's top level (a view made of a single child) removes itself when this view would
+    auto child_skip = [&](const std::string &member)
+    {
         if (root_region)
-        {
-            // Remove event handlers conditionally based on which branch is active
-            ss << "        if (_if_" << root_if_id << "_state) {\n";
-            // Remove handlers for then-branch elements
-            for (int el_id : root_region->then_element_ids)
-            {
-                if (masks.click && (masks.click & (1ULL << el_id)))
-                    ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.input && (masks.input & (1ULL << el_id)))
-                    ss << "            g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.change && (masks.change & (1ULL << el_id)))
-                    ss << "            g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.keydown && (masks.keydown & (1ULL << el_id)))
-                    ss << "            g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-            }
-            // Remove the then-branch root element
-            if (!root_region->then_element_ids.empty())
-            {
-                ss << "            webcc::dom::remove_element(el[" << root_region->then_element_ids[0] << "]);\n";
-            }
-            ss << "        } else {\n";
-            // Remove handlers for else-branch elements
-            for (int el_id : root_region->else_element_ids)
-            {
-                if (masks.click && (masks.click & (1ULL << el_id)))
-                    ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.input && (masks.input & (1ULL << el_id)))
-                    ss << "            g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.change && (masks.change & (1ULL << el_id)))
-                    ss << "            g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.keydown && (masks.keydown & (1ULL << el_id)))
-                    ss << "            g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-            }
-            // Remove the else-branch root element
-            if (!root_region->else_element_ids.empty())
-            {
-                ss << "            webcc::dom::remove_element(el[" << root_region->else_element_ids[0] << "]);\n";
-            }
-            ss << "        }\n";
-        }
+            return std::string(root_exposed.components.count(member) ? "skip_dom_removal" : "true");
+        return std::string(element_count > 0 ? "true" : "skip_dom_removal");
+    };
+
+    // Debug audit after teardown: entries still tagged with the instance, plus foreign handlers on its elements
+    std::string audit_els = element_count > 0 ? "el, " + std::to_string(element_count) : "nullptr, 0";
+
+    // Destroy method
+    // skip_dom_removal: if true, only releases handlers and children (an ancestor's DOM removal covers the view)
+    ss << "    void _destroy(bool skip_dom_removal = false) {\n";
+    ss << handler_removal;
+    // Pending timer, request and websocket callbacks would otherwise resume into the freed instance
+    for (const auto &table : g_callback_tables)
+    {
+        ss << "        " << table << ".remove_owner(this);\n";
     }
-    else if (!conditional_els.empty())
+    ss << dom_removal.str();
+    for (auto const &[comp_name, count] : component_members)
     {
-        // Has if/else regions but not at root level - need conditional cleanup
-        // First remove unconditional element handlers
-        for (int i = 0; i < element_count; ++i)
-        {
-            if (conditional_els.count(i))
-                continue; // Skip conditional elements
-            if (masks.click && (masks.click & (1ULL << i)))
-                ss << "        g_dispatcher.remove(el[" << i << "]);\n";
-            if (masks.input && (masks.input & (1ULL << i)))
-                ss << "        g_input_dispatcher.remove(el[" << i << "]);\n";
-            if (masks.change && (masks.change & (1ULL << i)))
-                ss << "        g_change_dispatcher.remove(el[" << i << "]);\n";
-            if (masks.keydown && (masks.keydown & (1ULL << i)))
-                ss << "        g_keydown_dispatcher.remove(el[" << i << "]);\n";
-        }
-        // Now handle each if region's conditional elements
-        for (const auto &region : if_regions)
+        for (int i = 0; i < count; ++i)
         {
-            ss << "        if (_if_" << region.if_id << "_state) {\n";
-            for (int el_id : region.then_element_ids)
+            std::string member = comp_name + "_" + std::to_string(i);
+            if (lazy_members.count(member))
             {
-                if (masks.click && (masks.click & (1ULL << el_id)))
-                    ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.input && (masks.input & (1ULL << el_id)))
-                    ss << "            g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.change && (masks.change & (1ULL << el_id)))
-                    ss << "            g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.keydown && (masks.keydown & (1ULL << el_id)))
-                    ss << "            g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
+                // Free the children of active if-branches, which the parent allocated
+                ss << "        if (" << member << ") { " << member << "->_destroy(" << child_skip(member) << "); delete "
+                   << member << "; " << member << " = nullptr; }\n";
             }
-            ss << "        } else {\n";
-            for (int el_id : region.else_element_ids)
+            else
             {
-                if (masks.click && (masks.click & (1ULL << el_id)))
-                    ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.input && (masks.input & (1ULL << el_id)))
-                    ss << "            g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.change && (masks.change & (1ULL << el_id)))
-                    ss << "            g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.keydown && (masks.keydown & (1ULL << el_id)))
-                    ss << "            g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
+                ss << "        " << member << "._destroy(" << child_skip(member) << ");\n";
             }
-            ss << "        }\n";
-        }
-        // Remove root element (which removes all children)
-        if (element_count > 0)
-        {
-            ss << "        webcc::dom::remove_element(el[0]);\n";
         }
     }
-    else
+    // Items of component loops (one vector per component type, shared by its loops)
+    std::map<std::string, std::string> loop_item_skip;
+    for (const auto &lr : loop_regions)
     {
-        // No if/else regions at all, use the original simple approach
-        if (masks.click)
-            ss << "        for (int i = 0; i < " << element_count << "; i++) if (_click_mask & (1ULL << i)) g_dispatcher.remove(el[i]);\n";
-        if (masks.input)
-            ss << "        for (int i = 0; i < " << element_count << "; i++) if (_input_mask & (1ULL << i)) g_input_dispatcher.remove(el[i]);\n";
-        if (masks.change)
-            ss << "        for (int i = 0; i < " << element_count << "; i++) if (_change_mask & (1ULL << i)) g_change_dispatcher.remove(el[i]);\n";
-        if (masks.keydown)
-            ss << "        for (int i = 0; i < " << element_count << "; i++) if (_keydown_mask & (1ULL << i)) g_keydown_dispatcher.remove(el[i]);\n";
-        if (element_count > 0)
-        {
-            ss << "        webcc::dom::remove_element(el[0]);\n";
-        }
+        if (lr.component_type.empty() || lr.is_member_ref_loop)
+            continue;
+        std::string skip = root_region ? (root_exposed.loops.count(lr.loop_id) ? "skip_dom_removal" : "true")
+                                       : (element_count > 0 ? "true" : "skip_dom_removal");
+        auto it = loop_item_skip.find(lr.component_type);
+        if (it == loop_item_skip.end() || skip != "true")
+            loop_item_skip[lr.component_type] = skip;
+    }
+    for (const auto &[comp_name, skip] : loop_item_skip)
+    {
+        std::string vec_name = "_loop_" + comp_name + "s";
+        ss << "        for (int _i = 0; _i < (int)" << vec_name << ".size(); _i++) " << vec_name << "[_i]._destroy(" << skip
+           << ");\n";
     }
     // Cleanup route components
     if (component.router)
@@ -184,164 +166,57 @@ void emit_component_lifecycle_methods(std::stringstream &ss,
             ss << "        if (_route_" << i << ") { _route_" << i << "->_destroy(); delete _route_" << i << "; }\n";
         }
     }
+    if (g_debug_build)
+    {
+        ss << "        _mem.update(false, _measure_memory());\n";
+        ss << "        __coi_mem::audit_dispatchers(this, " << audit_els << ", _component_name(), false);\n";
+    }
     ss << "    }\n";
 
     // Remove view method - removes DOM elements but keeps component state intact
     // Used for member references inside if-statements that toggle visibility
     // skip_dom_removal: if true, only unregisters handlers (caller will bulk-clear DOM)
     ss << "    void _remove_view(bool skip_dom_removal = false) {\n";
-
-    // If we have if/else at root level, handle both branches
-    if (root_if_id >= 0 && !if_regions.empty())
-    {
-        const IfRegion *root_region = nullptr;
-        for (const auto &region : if_regions)
-        {
-            if (region.if_id == root_if_id)
-            {
-                root_region = &region;
-                break;
-            }
-        }
-        if (root_region)
-        {
-            ss << "        if (_if_" << root_if_id << "_state) {\n";
-            // Remove handlers for then-branch elements
-            for (int el_id : root_region->then_element_ids)
-            {
-                if (masks.click && (masks.click & (1ULL << el_id)))
-                    ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-            }
-            // Remove the then-branch root element
-            if (!root_region->then_element_ids.empty())
-            {
-                ss << "            if (!skip_dom_removal) webcc::dom::remove_element(el[" << root_region->then_element_ids[0] << "]);\n";
-            }
-            ss << "        } else {\n";
-            // Remove handlers for else-branch elements
-            for (int el_id : root_region->else_element_ids)
-            {
-                if (masks.click && (masks.click & (1ULL << el_id)))
-                    ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-            }
-            // Remove the else-branch root element
-            if (!root_region->else_element_ids.empty())
-            {
-                ss << "            if (!skip_dom_removal) webcc::dom::remove_element(el[" << root_region->else_element_ids[0] << "]);\n";
-            }
-            ss << "        }\n";
-            // Also remove the anchor
-            ss << "        if (!skip_dom_removal) webcc::dom::remove_element(_if_" << root_if_id << "_anchor);\n";
-        }
-    }
-    else if (!conditional_els.empty())
+    ss << handler_removal;
+    // Remove child component views recursively
+    for (auto const &[comp_name, count] : component_members)
     {
-        // Has if/else regions but not at root level - need conditional cleanup
-        // First remove unconditional element handlers
-        for (int i = 0; i < element_count; ++i)
-        {
-            if (conditional_els.count(i))
-                continue; // Skip conditional elements
-            if (masks.click && (masks.click & (1ULL << i)))
-                ss << "        g_dispatcher.remove(el[" << i << "]);\n";
-            if (masks.input && (masks.input & (1ULL << i)))
-                ss << "        g_input_dispatcher.remove(el[" << i << "]);\n";
-            if (masks.change && (masks.change & (1ULL << i)))
-                ss << "        g_change_dispatcher.remove(el[" << i << "]);\n";
-            if (masks.keydown && (masks.keydown & (1ULL << i)))
-                ss << "        g_keydown_dispatcher.remove(el[" << i << "]);\n";
-        }
-        // Now handle each if region's conditional elements
-        for (const auto &region : if_regions)
-        {
-            ss << "        if (_if_" << region.if_id << "_state) {\n";
-            for (int el_id : region.then_element_ids)
-            {
-                if (masks.click && (masks.click & (1ULL << el_id)))
-                    ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.input && (masks.input & (1ULL << el_id)))
-                    ss << "            g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.change && (masks.change & (1ULL << el_id)))
-                    ss << "            g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.keydown && (masks.keydown & (1ULL << el_id)))
-                    ss << "            g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-            }
-            ss << "        } else {\n";
-            for (int el_id : region.else_element_ids)
-            {
-                if (masks.click && (masks.click & (1ULL << el_id)))
-                    ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.input && (masks.input & (1ULL << el_id)))
-                    ss << "            g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.change && (masks.change & (1ULL << el_id)))
-                    ss << "            g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                if (masks.keydown && (masks.keydown & (1ULL << el_id)))
-                    ss << "            g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-            }
-            ss << "        }\n";
-        }
-        // Remove child component views recursively
-        for (auto const &[comp_name, count] : component_members)
-        {
-            for (int i = 0; i < count; ++i)
-            {
-                ss << "        " << comp_name << "_" << i << "._remove_view(skip_dom_removal);\n";
-            }
-        }
-        // Remove root element (which removes all children)
-        if (element_count > 0)
+        for (int i = 0; i < count; ++i)
         {
-            ss << "        if (!skip_dom_removal) webcc::dom::remove_element(el[0]);\n";
+            std::string member = comp_name + "_" + std::to_string(i);
+            if (lazy_members.count(member))
+                ss << "        if (" << member << ") " << member << "->_remove_view(" << child_skip(member) << ");\n";
+            else
+                ss << "        " << member << "._remove_view(" << child_skip(member) << ");\n";
         }
     }
-    else
+    ss << dom_removal.str();
+    if (g_debug_build)
     {
-        // No if/else regions at all, use the original simple approach
-        // Remove all event handlers
-        if (masks.click)
-            ss << "        for (int i = 0; i < " << element_count << "; i++) if (_click_mask & (1ULL << i)) g_dispatcher.remove(el[i]);\n";
-        if (masks.input)
-            ss << "        for (int i = 0; i < " << element_count << "; i++) if (_input_mask & (1ULL << i)) g_input_dispatcher.remove(el[i]);\n";
-        if (masks.change)
-            ss << "        for (int i = 0; i < " << element_count << "; i++) if (_change_mask & (1ULL << i)) g_change_dispatcher.remove(el[i]);\n";
-        if (masks.keydown)
-            ss << "        for (int i = 0; i < " << element_count << "; i++) if (_keydown_mask & (1ULL << i)) g_keydown_dispatcher.remove(el[i]);\n";
-        // Remove child component views recursively
-        for (auto const &[comp_name, count] : component_members)
-        {
-            for (int i = 0; i < count; ++i)
-            {
-                ss << "        " << comp_name << "_" << i << "._remove_view(skip_dom_removal);\n";
-            }
-        }
-        // Remove root element (which removes all children)
-        if (element_count > 0)
-        {
-            ss << "        if (!skip_dom_removal) webcc::dom::remove_element(el[0]);\n";
-        }
+        ss << "        _mem.update(false, _measure_memory());\n";
+        ss << "        __coi_mem::audit_dispatchers(this, " << audit_els << ", _component_name(), true);\n";
     }
     ss << "    }\n";
 
     // _get_root_element method - returns the root DOM element for this component
     // Handles if/else at root level by checking _if_X_state
     ss << "    webcc::handle _get_root_element() {\n";
-    if (root_if_id >= 0)
+    if (root_region)
     {
         // Has if/else at root level
-        auto &root_region = if_regions[root_if_id];
         ss << "        if (_if_" << root_if_id << "_state) {\n";
-        if (!root_region.then_element_ids.empty())
+        if (!root_region->then_element_ids.empty())
         {
-            ss << "            return el[" << root_region.then_element_ids[0] << "];\n";
+            ss << "            return el[" << root_region->then_element_ids[0] << "];\n";
         }
         else
         {
             ss << "            return webcc::handle{0};\n";
         }
         ss << "        } else {\n";
-        if (!root_region.else_element_ids.empty())
+        if (!root_region->else_element_ids.empty())
         {
-            ss << "            return el[" << root_region.else_element_ids[0] << "];\n";
+            ss << "            return el[" << root_region->else_element_ids[0] << "];\n";
         }
         else
         {
@@ -404,7 +279,11 @@ void emit_component_lifecycle_methods(std::stringstream &ss,
             {
                 for (int i = 0; i < count; ++i)
                 {
-                    ss << "        " << comp_name << "_" << i << ".tick(dt);\n";
+                    std::string member = comp_name + "_" + std::to_string(i);
+                    if (lazy_members.count(member))
+                        ss << "        if (" << member << ") " << member << "->tick(dt);\n";
+                    else
+                        ss << "        " << member << ".tick(dt);\n";
                 }
             }
         }
@@ -1,4 +1,5 @@
 #include "component.h"
+#include "../codegen_state.h"
 
 void emit_component_router_methods(std::stringstream &ss, const Component &component)
 {
@@ -50,6 +51,12 @@ void emit_component_router_methods(std::stringstream &ss, const Component &compo
     // Helper lambda to generate component creation code
     auto emit_route_creation = [&](size_t i, const RouteEntry &route)
     {
+        // Enable the route's stylesheet; it was attached at startup, so it applies without a fetch
+        auto sheet = g_route_stylesheets.find(qualified_name(route.module_name, route.component_name));
+        if (sheet != g_route_stylesheets.end())
+        {
+            ss << "            webcc::dom::set_attribute(" << sheet->second << ", \"media\", \"all\");\n";
+        }
         ss << "            _route_" << i << " = new " << qualified_name(route.module_name, route.component_name) << "{";
         // Pass arguments - same handling as component construction
         // Reference args (&) that are identifiers are callbacks and need lambda wrapping
@@ -88,7 +95,7 @@ void emit_component_router_methods(std::stringstream &ss, const Component &compo
         ss << "            _route_" << i << "->view(_route_parent);\n";
         // Move the routed component's root element before the anchor
         ss << "            webcc::dom::insert_before(_route_parent, _route_" << i << "->_get_root_element(), _route_anchor);\n";
-        ss << "            webcc::flush();\n";
+        ss << "            g_dom_writes.flush();\n";
     };
 
     // Create the component for matching route and insert before anchor
@@ -3,6 +3,8 @@
 #include "../formatter.h"
 #include "../../defs/def_parser.h"
 #include "../../codegen/codegen_utils.h"
+#include "../../codegen/tree_shaker.h"
+#include "../../cli/error.h"
 #include <cctype>
 #include <algorithm>
 #include <sstream>
@@ -118,13 +120,34 @@ static std::string indent_code(const std::string &code, const std::string &prefi
 // Code Generation Helpers
 // ============================================================================
 
-static void emit_component_members(std::stringstream &ss, const std::map<std::string, int> &component_members)
+// Child components that live in a reactive if-branch, by member name
+static std::set<std::string> collect_lazy_members(const std::vector<IfRegion> &if_regions)
+{
+    std::set<std::string> lazy_members;
+    for (const auto &region : if_regions)
+    {
+        for (const auto &[comp_name, inst_id] : region.then_components)
+            lazy_members.insert(comp_name + "_" + std::to_string(inst_id));
+        for (const auto &[comp_name, inst_id] : region.else_components)
+            lazy_members.insert(comp_name + "_" + std::to_string(inst_id));
+    }
+    return lazy_members;
+}
+
+// If-branch children are only allocated while their branch is active, so hidden panels cost
+// a pointer until first shown
+static void emit_component_members(std::stringstream &ss, const std::map<std::string, int> &component_members,
+                                   const std::set<std::string> &lazy_members)
 {
     for (const auto &[comp_name, count] : component_members)
     {
         for (int i = 0; i < count; ++i)
         {
-            ss << "    " << comp_name << " " << comp_name << "_" << i << ";\n";
+            std::string member = comp_name + "_" + std::to_string(i);
+            if (lazy_members.count(member))
+                ss << "    " << comp_name << "* " << member << " = nullptr;\n";
+            else
+                ss << "    " << comp_name << " " << member << ";\n";
         }
     }
 }
@@ -156,9 +179,35 @@ static void emit_loop_region_members(std::stringstream &ss, const std::vector<Lo
         {
             ss << "    coi::vector<webcc::handle> _loop_" << region.loop_id << "_elements;\n";
         }
+        if (!region.row_dispatchers.empty())
+        {
+            // Handler-bearing elements of each row, parallel to _loop_X_elements
+            ss << "    coi::vector<coi::vector<webcc::handle>> _loop_" << region.loop_id << "_handlers;\n";
+        }
     }
 }
 
+// Drop the dispatcher entries one row of an HTML loop registered (row: a coi::vector of handles)
+static void emit_row_handler_removal(std::stringstream &ss, const LoopRegion &region, const std::string &row,
+                                     const std::string &indent)
+{
+    ss << indent << "for (int _h = 0; _h < (int)" << row << ".size(); _h++) {";
+    for (const auto &dispatcher : region.row_dispatchers)
+        ss << " " << dispatcher << ".remove(" << row << "[_h]);";
+    ss << " }\n";
+}
+
+// Drop the handlers of every row of an HTML loop and forget the rows
+static void emit_loop_handler_removal(std::stringstream &ss, const LoopRegion &region, const std::string &indent)
+{
+    if (region.row_dispatchers.empty())
+        return;
+    std::string handlers_vec = "_loop_" + std::to_string(region.loop_id) + "_handlers";
+    ss << indent << "for (int _r = 0; _r < (int)" << handlers_vec << ".size(); _r++)\n";
+    emit_row_handler_removal(ss, region, handlers_vec + "[_r]", indent + "    ");
+    ss << indent << handlers_vec << ".clear();\n";
+}
+
 static void emit_if_region_members(std::stringstream &ss, const std::vector<IfRegion> &if_regions)
 {
     for (const auto &region : if_regions)
@@ -166,9 +215,247 @@ static void emit_if_region_members(std::stringstream &ss, const std::vector<IfRe
         ss << "    webcc::handle _if_" << region.if_id << "_parent;\n";
         ss << "    webcc::handle _if_" << region.if_id << "_anchor;\n";
         ss << "    bool _if_" << region.if_id << "_state = false;\n";
+        if (region.keep)
+        {
+            // Kept branches are built on first show; a binding skipped while its branch is
+            // hidden marks the branch stale, and it is refreshed when shown again
+            ss << "    bool _if_" << region.if_id << "_then_built = false;\n";
+            ss << "    bool _if_" << region.if_id << "_else_built = false;\n";
+            ss << "    bool _if_" << region.if_id << "_then_stale = false;\n";
+            ss << "    bool _if_" << region.if_id << "_else_stale = false;\n";
+        }
+    }
+}
+
+// Tear down the live branch of an if region before the other one is built: detach its handlers,
+// remove its top-level DOM nodes and release its children. Children and loops nested inside a
+// removed node skip their own DOM removal, which the node's removal already covers.
+static void emit_branch_teardown(std::stringstream &ss, const IfRegion &region, bool then_branch,
+                                 const std::vector<IfRegion> &if_regions,
+                                 const std::vector<LoopRegion> &loop_regions,
+                                 const std::vector<EventHandler> &event_handlers)
+{
+    const auto &element_ids = then_branch ? region.then_element_ids : region.else_element_ids;
+    const auto &components = then_branch ? region.then_components : region.else_components;
+    const auto &member_refs = then_branch ? region.then_member_refs : region.else_member_refs;
+    const auto &loop_ids = then_branch ? region.then_loop_ids : region.else_loop_ids;
+    const auto &nested_if_ids = then_branch ? region.then_if_ids : region.else_if_ids;
+
+    // Elements owned by nested ifs only have handlers while their own branch is live
+    std::set<int> nested_if_els;
+    for (int nested_if_id : nested_if_ids)
+    {
+        for (const auto &nested_region : if_regions)
+        {
+            if (nested_region.if_id == nested_if_id)
+            {
+                nested_if_els.insert(nested_region.then_element_ids.begin(), nested_region.then_element_ids.end());
+                nested_if_els.insert(nested_region.else_element_ids.begin(), nested_region.else_element_ids.end());
+            }
+        }
+    }
+    std::vector<int> own_els;
+    for (int el_id : element_ids)
+    {
+        if (!nested_if_els.count(el_id))
+            own_els.push_back(el_id);
+    }
+    emit_element_event_removals(ss, event_handlers, own_els, "            ");
+    for (int nested_if_id : nested_if_ids)
+    {
+        for (const auto &nested_region : if_regions)
+        {
+            if (nested_region.if_id != nested_if_id)
+                continue;
+            std::stringstream then_removals, else_removals;
+            emit_element_event_removals(then_removals, event_handlers, nested_region.then_element_ids, "");
+            emit_element_event_removals(else_removals, event_handlers, nested_region.else_element_ids, "");
+            std::string line;
+            while (std::getline(then_removals, line))
+                ss << "            if (_if_" << nested_if_id << "_state) " << line << "\n";
+            while (std::getline(else_removals, line))
+                ss << "            if (!_if_" << nested_if_id << "_state) " << line << "\n";
+        }
+    }
+
+    BranchExposure exposed;
+    emit_branch_dom_removal(ss, region, then_branch, if_regions, loop_regions, "            ", "", exposed);
+
+    for (const auto &[comp_name, inst_id] : components)
+    {
+        std::string member = comp_name + "_" + std::to_string(inst_id);
+        std::string skip = exposed.components.count(member) ? "" : "true";
+        ss << "            if (" << member << ") { " << member << "->_destroy(" << skip << "); delete " << member << "; "
+           << member << " = nullptr; }\n";
+    }
+    // Remove view from member references (keeps component state, just removes DOM)
+    for (const auto &member_name : member_refs)
+    {
+        std::string skip = exposed.member_refs.count(member_name) ? "" : "true";
+        ss << "            " << member_name << "._remove_view(" << skip << ");\n";
+    }
+    for (int loop_id : loop_ids)
+    {
+        for (const auto &lr : loop_regions)
+        {
+            if (lr.loop_id != loop_id)
+                continue;
+            if (!lr.component_type.empty())
+            {
+                std::string vec_name = "_loop_" + lr.component_type + "s";
+                std::string skip = exposed.loops.count(loop_id) ? "" : "true";
+                ss << "            while ((int)" << vec_name << ".size() > 0) {\n";
+                ss << "                " << vec_name << "[" << vec_name << ".size() - 1]._destroy(" << skip << ");\n";
+                ss << "                " << vec_name << ".pop_back();\n";
+                ss << "            }\n";
+                ss << "            _loop_" << loop_id << "_count = 0;\n";
+            }
+            else if (lr.is_html_loop)
+            {
+                // Items were removed above with the node holding them
+                std::string vec_name = "_loop_" + std::to_string(loop_id) + "_elements";
+                emit_loop_handler_removal(ss, lr, "            ");
+                ss << "            while ((int)" << vec_name << ".size() > 0) " << vec_name << ".pop_back();\n";
+                ss << "            _loop_" << loop_id << "_count = 0;\n";
+            }
+            break;
+        }
     }
 }
 
+// Register the handlers of a branch's elements. Elements of a nested if are only registered for
+// the branch its state says is live; the other branch's handles are kept after removal.
+static void emit_live_branch_registrations(std::stringstream &ss, const std::vector<EventHandler> &event_handlers,
+                                           const std::vector<int> &element_ids,
+                                           const std::vector<int> &nested_if_ids,
+                                           const std::vector<IfRegion> &if_regions, const std::string &indent)
+{
+    std::set<int> nested_if_els;
+    for (int nested_if_id : nested_if_ids)
+    {
+        for (const auto &nested_region : if_regions)
+        {
+            if (nested_region.if_id == nested_if_id)
+            {
+                nested_if_els.insert(nested_region.then_element_ids.begin(), nested_region.then_element_ids.end());
+                nested_if_els.insert(nested_region.else_element_ids.begin(), nested_region.else_element_ids.end());
+            }
+        }
+    }
+    std::vector<int> own_els;
+    for (int el_id : element_ids)
+    {
+        if (!nested_if_els.count(el_id))
+            own_els.push_back(el_id);
+    }
+    emit_element_event_registrations(ss, event_handlers, own_els, indent);
+
+    for (int nested_if_id : nested_if_ids)
+    {
+        for (const auto &nested_region : if_regions)
+        {
+            if (nested_region.if_id != nested_if_id)
+                continue;
+            std::stringstream then_regs, else_regs;
+            emit_live_branch_registrations(then_regs, event_handlers, nested_region.then_element_ids,
+                                           nested_region.then_if_ids, if_regions, indent + "    ");
+            emit_live_branch_registrations(else_regs, event_handlers, nested_region.else_element_ids,
+                                           nested_region.else_if_ids, if_regions, indent + "    ");
+            if (then_regs.str().empty() && else_regs.str().empty())
+                continue;
+            ss << indent << "if (_if_" << nested_if_id << "_state) {\n";
+            ss << then_regs.str();
+            ss << indent << "} else {\n";
+            ss << else_regs.str();
+            ss << indent << "}\n";
+        }
+    }
+}
+
+// _sync_if_X() for <if keep>: a branch is built the first time it is shown, then hidden and shown
+// by toggling the `hidden` property of its top-level nodes. The hidden branch's own handlers are
+// detached (and kept out of _rebind by _hidden_mask); bindings that changed while it was hidden
+// are refreshed when it is shown again. Child components keep running while hidden.
+static void emit_kept_if_sync(std::stringstream &ss, const IfRegion &region,
+                              const std::vector<IfRegion> &if_regions,
+                              const std::vector<EventHandler> &event_handlers,
+                              const std::vector<std::string> &then_updates,
+                              const std::vector<std::string> &else_updates)
+{
+    std::string prefix = "_if_" + std::to_string(region.if_id);
+
+    auto branch_mask = [](const std::vector<int> &element_ids)
+    {
+        uint64_t mask = 0;
+        for (int el_id : element_ids)
+        {
+            if (el_id < 64)
+                mask |= 1ULL << el_id;
+        }
+        return mask;
+    };
+    auto hex = [](uint64_t mask)
+    {
+        std::stringstream out;
+        out << "0x" << std::hex << mask << "ULL";
+        return out.str();
+    };
+
+    auto emit_switch = [&](bool show_then)
+    {
+        const std::string shown = show_then ? "then" : "else";
+        const std::string hidden = show_then ? "else" : "then";
+        const auto &shown_ids = show_then ? region.then_element_ids : region.else_element_ids;
+        const auto &hidden_ids = show_then ? region.else_element_ids : region.then_element_ids;
+        const auto &shown_roots = show_then ? region.then_roots : region.else_roots;
+        const auto &hidden_roots = show_then ? region.else_roots : region.then_roots;
+        const std::string &creation = show_then ? region.then_creation_code : region.else_creation_code;
+        const auto &updates = show_then ? then_updates : else_updates;
+        bool has_handlers = !event_handlers.empty();
+
+        if (!hidden_roots.empty())
+        {
+            ss << "            if (" << prefix << "_" << hidden << "_built) {\n";
+            emit_element_event_removals(ss, event_handlers, hidden_ids, "                ");
+            for (const auto &root : hidden_roots)
+                ss << "                g_dom_writes.property(" << root << ", \"hidden\", \"true\");\n";
+            ss << "            }\n";
+        }
+        if (has_handlers)
+        {
+            ss << "            _hidden_mask = (_hidden_mask | " << hex(branch_mask(hidden_ids)) << ") & ~"
+               << hex(branch_mask(shown_ids)) << ";\n";
+        }
+        ss << "            if (!" << prefix << "_" << shown << "_built) {\n";
+        ss << "            " << prefix << "_" << shown << "_built = true;\n";
+        ss << creation;
+        ss << "            } else {\n";
+        for (const auto &root : shown_roots)
+            ss << "                g_dom_writes.property(" << root << ", \"hidden\", \"\");\n";
+        if (!updates.empty())
+        {
+            ss << "                if (" << prefix << "_" << shown << "_stale) {\n";
+            for (const auto &method : updates)
+                ss << "                    " << method << "();\n";
+            ss << "                }\n";
+        }
+        ss << "            }\n";
+        ss << "            " << prefix << "_" << shown << "_stale = false;\n";
+        emit_live_branch_registrations(ss, event_handlers, shown_ids, show_then ? region.then_if_ids : region.else_if_ids,
+                                       if_regions, "            ");
+    };
+
+    ss << "    void _sync_if_" << region.if_id << "() {\n";
+    ss << "        bool new_state = " << region.condition_code << ";\n";
+    ss << "        if (new_state == " << prefix << "_state) return;\n";
+    ss << "        " << prefix << "_state = new_state;\n";
+    ss << "        if (new_state) {\n";
+    emit_switch(true);
+    ss << "        } else {\n";
+    emit_switch(false);
+    ss << "        }\n";
+    ss << "    }\n";
+}
 
 // ============================================================================
 // Tree Traversal Functions
@@ -293,9 +580,14 @@ std::string Component::to_webcc(CompilerSession &session)
         ComponentTypeContext::instance().set_component_symbol_type(param->name, param->type);
     }
 
+    g_computed_members.clear();
     for (auto &var : state)
     {
         ComponentTypeContext::instance().set_component_symbol_type(var->name, var->type);
+        if (var->is_computed)
+        {
+            g_computed_members.insert(var->name);
+        }
     }
 
     // Collect child components
@@ -413,6 +705,15 @@ std::string Component::to_webcc(CompilerSession &session)
     // Note: Data types and enums are now flattened to global scope with ComponentName_ prefix
     ss << "struct " << qualified_name(module_name, name) << " {\n";
 
+    // Instances created with new (the root, routed components, if-branch children) come from the
+    // app's allocator
+    if (!g_heap_allocator.empty())
+    {
+        ss << "    static void* operator new(size_t size) { return coi::malloc(size); }\n";
+        ss << "    static void* operator new(size_t, void* ptr) { return ptr; }\n";
+        ss << "    static void operator delete(void* ptr) { coi::free(ptr); }\n";
+    }
+
     // Component parameters (data members only - callbacks emitted later for proper aggregate init order)
     for (auto &param : params)
     {
@@ -435,6 +736,14 @@ std::string Component::to_webcc(CompilerSession &session)
     // State variables (data members only - callbacks emitted later)
     for (auto &var : state)
     {
+        // Computed members hold a cached value and a dirty flag; the getter is emitted with the methods
+        if (var->is_computed)
+        {
+            ss << "    " << convert_type(resolve_component_type(var->type)) << " _computed_" << var->name << "_value;\n";
+            ss << "    bool _computed_" << var->name << "_dirty = true;\n";
+            continue;
+        }
+
         // Special handling for array literals
         if (auto arr_lit = dynamic_cast<ArrayLiteral *>(var->initializer.get()))
         {
@@ -543,7 +852,8 @@ std::string Component::to_webcc(CompilerSession &session)
     emit_event_mask_constants(ss, masks);
 
     // Child component members
-    emit_component_members(ss, component_members);
+    std::set<std::string> lazy_members = collect_lazy_members(if_regions);
+    emit_component_members(ss, component_members, lazy_members);
 
     // Vector members for components in loops
     emit_loop_vector_members(ss, loop_component_types);
@@ -553,6 +863,17 @@ std::string Component::to_webcc(CompilerSession &session)
 
     // If region tracking
     emit_if_region_members(ss, if_regions);
+    std::set<int> keep_if_ids;
+    for (const auto &region : if_regions)
+    {
+        if (region.keep)
+            keep_if_ids.insert(region.if_id);
+    }
+    bool has_keep = !keep_if_ids.empty();
+    if (has_keep && !event_handlers.empty())
+    {
+        ss << "    uint64_t _hidden_mask = 0;  // Elements of hidden <if keep> branches\n";
+    }
 
     // Router state (if router block defined)
     if (router)
@@ -568,6 +889,69 @@ std::string Component::to_webcc(CompilerSession &session)
         }
     }
 
+    // Computed member dependencies, closed over other computed members. A computed member is
+    // invalidated whenever one of the state variables or params it (transitively) reads changes.
+    std::map<std::string, std::set<std::string>> computed_deps;
+    std::map<std::string, std::set<MemberDependency>> computed_member_deps;
+    std::vector<std::string> computed_order;
+    for (auto &var : state)
+    {
+        if (var->is_computed)
+        {
+            var->initializer->collect_dependencies(computed_deps[var->name]);
+            var->initializer->collect_member_dependencies(computed_member_deps[var->name]);
+            computed_order.push_back(var->name);
+        }
+    }
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (const auto &name : computed_order)
+        {
+            for (const auto &other : computed_order)
+            {
+                if (other == name || !computed_deps[name].count(other))
+                    continue;
+                size_t before = computed_deps[name].size() + computed_member_deps[name].size();
+                computed_deps[name].insert(computed_deps[other].begin(), computed_deps[other].end());
+                computed_member_deps[name].insert(computed_member_deps[other].begin(), computed_member_deps[other].end());
+                changed |= computed_deps[name].size() + computed_member_deps[name].size() != before;
+            }
+        }
+    }
+    for (auto &var : state)
+    {
+        if (var->is_computed && computed_deps[var->name].count(var->name))
+        {
+            ErrorHandler::compiler_error("Computed member '" + var->name + "' depends on itself", var->line);
+        }
+    }
+
+    for (const auto &name : computed_order)
+    {
+        for (const auto &dep : computed_deps[name])
+        {
+            g_computed_dependents[dep].insert(name);
+        }
+    }
+
+    // Computed members affected by a set of modified variables (in declaration order)
+    auto affected_computed = [&](const std::set<std::string> &modified_vars) {
+        std::vector<std::string> affected;
+        for (const auto &name : computed_order)
+        {
+            for (const auto &dep : computed_deps[name])
+            {
+                if (modified_vars.count(dep))
+                {
+                    affected.push_back(name);
+                    break;
+                }
+            }
+        }
+        return affected;
+    };
+
     // Build update entries map
     struct UpdateEntry
     {
@@ -624,16 +1008,17 @@ std::string Component::to_webcc(CompilerSession &session)
             // - value: for input/textarea/select current value (attribute only sets default)
             // - checked: for checkbox/radio current checked state
             // - selected: for option current selected state
+            // Updates go through g_dom_writes, which keeps only the last write per slot until the flush
             if (binding.name == "value" || binding.name == "checked" || binding.name == "selected") {
-                dom_call = "webcc::dom::set_property(" + el_var + ", \"" + binding.name + "\", ";
+                dom_call = "g_dom_writes.property(" + el_var + ", \"" + binding.name + "\", ";
             } else {
-                dom_call = "webcc::dom::set_attribute(" + el_var + ", \"" + binding.name + "\", ";
+                dom_call = "g_dom_writes.attribute(" + el_var + ", \"" + binding.name + "\", ";
             }
         } else if (binding.type == "html") {
             // Raw HTML injection via <raw> element
-            dom_call = "webcc::dom::set_inner_html(" + el_var + ", ";
+            dom_call = "g_dom_writes.html(" + el_var + ", ";
         } else {
-            dom_call = "webcc::dom::set_inner_text(" + el_var + ", ";
+            dom_call = "g_dom_writes.text(" + el_var + ", ";
         }
 
         bool optimized = false;
@@ -686,6 +1071,7 @@ std::string Component::to_webcc(CompilerSession &session)
 
     // Generate shared element+attribute update methods
     int shared_update_counter = 0;
+    std::map<std::pair<int, bool>, std::vector<std::string>> kept_branch_updates;
     for (auto &[key, binding] : element_attr_bindings)
     {
         std::string method_name;
@@ -704,15 +1090,39 @@ std::string Component::to_webcc(CompilerSession &session)
 
         binding.method_name = method_name;
 
-        // Add this shared method to each dependency's update list
+        // Add this shared method to each dependency's update list. Bindings of kept branches
+        // always run their method, which marks a hidden branch stale instead of writing
+        bool kept = keep_if_ids.count(key.if_region_id) > 0;
         for (const auto &dep : binding.dependencies)
         {
             UpdateEntry entry;
             entry.code = method_name + "();";
-            entry.if_region_id = key.if_region_id;
+            entry.if_region_id = kept ? -1 : key.if_region_id;
             entry.in_then_branch = key.in_then_branch;
             var_update_entries[dep].push_back(entry);
         }
+        if (kept)
+        {
+            kept_branch_updates[{key.if_region_id, key.in_then_branch}].push_back(method_name);
+        }
+    }
+
+    // Params are updated by the parent through _update_<param>(), so computed members reading
+    // them are invalidated there rather than at the modifying method
+    std::set<std::string> param_names;
+    for (const auto &param : params)
+    {
+        param_names.insert(param->name);
+    }
+    for (const auto &name : computed_order)
+    {
+        for (const auto &dep : computed_deps[name])
+        {
+            if (param_names.count(dep))
+            {
+                var_update_entries[dep].push_back({"_invalidate_" + name + "();", -1, false});
+            }
+        }
     }
 
     // Build map from member dependencies to update method names
@@ -724,10 +1134,18 @@ std::string Component::to_webcc(CompilerSession &session)
             member_dep_update_methods[mem_dep].insert(binding.method_name);
         }
     }
+    for (const auto &name : computed_order)
+    {
+        for (const auto &mem_dep : computed_member_deps[name])
+        {
+            member_dep_update_methods[mem_dep].insert("_invalidate_" + name);
+        }
+    }
 
     // Generate shared element+attribute update methods first
     for (const auto &[key, binding] : element_attr_bindings)
     {
+        ss << shake_region_begin({binding.method_name});
         ss << "    void " << binding.method_name << "() {\n";
         if (key.if_region_id < 0)
         {
@@ -747,9 +1165,13 @@ std::string Component::to_webcc(CompilerSession &session)
                 ss << "            " << binding.update_code << "\n";
                 ss << "        }\n";
             }
+            if (keep_if_ids.count(key.if_region_id))
+            {
+                ss << "        else _if_" << key.if_region_id << (key.in_then_branch ? "_then" : "_else") << "_stale = true;\n";
+            }
         }
         ss << "    }\n";
-
+        ss << shake_region_end();
     }
 
     // Generate _update_{varname}() methods
@@ -758,6 +1180,7 @@ std::string Component::to_webcc(CompilerSession &session)
     {
         if (!entries.empty())
         {
+            ss << shake_region_begin({"_update_" + var_name});
             ss << "    void _update_" << var_name << "() {\n";
 
             // Deduplicate entries outside if regions
@@ -842,6 +1265,7 @@ std::string Component::to_webcc(CompilerSession &session)
                 ss << "        if(" << callback_name << ") " << callback_name << "();\n";
             }
             ss << "    }\n";
+            ss << shake_region_end();
             generated_updaters.insert(var_name);
         }
     }
@@ -909,10 +1333,10 @@ std::string Component::to_webcc(CompilerSession &session)
                 
                 ss << "        int _new_count = (int)" << region.iterable_expr << ".size();\n";
 
-                // Remove all existing HTML elements and cleanup dispatcher
+                // Remove all existing HTML elements and their rows' handlers
+                emit_loop_handler_removal(ss, region, "        ");
                 ss << "        for (auto& _el : " << elements_vec << ") {\n";
-                ss << "            g_dispatcher.remove(_el);\n";
-                ss << "            webcc::dom::remove_element(_el);\n";
+                ss << "            g_dom_writes.remove(_el);\n";
                 ss << "        }\n";
                 ss << "        " << elements_vec << ".clear();\n";
                 ss << "        \n";
@@ -920,7 +1344,7 @@ std::string Component::to_webcc(CompilerSession &session)
                 ss << "        for (int _idx = 0; _idx < _new_count; _idx++) {\n";
                 ss << "            _sync_loop_" << region.loop_id << "_item(_idx);\n";
                 ss << "        }\n";
-                ss << "        if (--g_view_depth == 0) webcc::flush();\n";
+                ss << "        if (--g_view_depth == 0) g_dom_writes.flush();\n";
                 ss << "        " << count_var << " = _new_count;\n";
             }
             else
@@ -948,7 +1372,7 @@ std::string Component::to_webcc(CompilerSession &session)
                 ss << indent_code(item_code, "        ");
 
                 ss << "        }\n";
-                ss << "        if (--g_view_depth == 0) webcc::flush();\n";
+                ss << "        if (--g_view_depth == 0) g_dom_writes.flush();\n";
                 ss << "        " << count_var << " = _new_count;\n";
             }
         }
@@ -991,6 +1415,7 @@ std::string Component::to_webcc(CompilerSession &session)
             else if (region.is_html_loop)
             {
                 std::string vec_name = "_loop_" + std::to_string(region.loop_id) + "_elements";
+                std::string handlers_vec = "_loop_" + std::to_string(region.loop_id) + "_handlers";
                 std::string anchor_var = "_loop_" + std::to_string(region.loop_id) + "_anchor";
 
                 ss << "        if (new_count > old_count) {\n";
@@ -998,16 +1423,28 @@ std::string Component::to_webcc(CompilerSession &session)
 
                 std::string item_code = region.item_creation_code;
                 item_code = transform_to_insert_before(item_code, region.parent_element, anchor_var);
+                if (!region.row_dispatchers.empty())
+                    ss << "            coi::vector<webcc::handle> _row_handlers;\n";
                 ss << indent_code(item_code, "    ");
 
                 if (!region.root_element_var.empty())
                 {
                     ss << "            " << vec_name << ".push_back(" << region.root_element_var << ");\n";
                 }
+                if (!region.row_dispatchers.empty())
+                    ss << "            " << handlers_vec << ".push_back(_row_handlers);\n";
                 ss << "            }\n";
                 ss << "        } else {\n";
+                if (!region.row_dispatchers.empty())
+                {
+                    ss << "            while ((int)" << handlers_vec << ".size() > new_count) {\n";
+                    ss << "                auto& _row = " << handlers_vec << "[" << handlers_vec << ".size() - 1];\n";
+                    emit_row_handler_removal(ss, region, "_row", "                ");
+                    ss << "                " << handlers_vec << ".pop_back();\n";
+                    ss << "            }\n";
+                }
                 ss << "            while ((int)" << vec_name << ".size() > new_count) {\n";
-                ss << "                webcc::dom::remove_element(" << vec_name << "[" << vec_name << ".size() - 1]);\n";
+                ss << "                g_dom_writes.remove(" << vec_name << "[" << vec_name << ".size() - 1]);\n";
                 ss << "                " << vec_name << ".pop_back();\n";
                 ss << "            }\n";
                 ss << "        }\n";
@@ -1024,22 +1461,32 @@ std::string Component::to_webcc(CompilerSession &session)
             continue;
 
         std::string elements_vec = "_loop_" + std::to_string(region.loop_id) + "_elements";
+        std::string handlers_vec = "_loop_" + std::to_string(region.loop_id) + "_handlers";
         std::string parent_var = "_loop_" + std::to_string(region.loop_id) + "_parent";
         std::string anchor_var = "_loop_" + std::to_string(region.loop_id) + "_anchor";
+        bool row_handlers = !region.row_dispatchers.empty();
 
         ss << "    void _sync_loop_" << region.loop_id << "_item(int _idx) {\n";
         ss << "        if (_idx < 0 || _idx >= (int)" << region.iterable_expr << ".size()) return;\n";
         ss << "        webcc::handle _ref = " << anchor_var << ";\n";
         ss << "        if (_idx < (int)" << elements_vec << ".size()) {\n";
         ss << "            webcc::handle _old = " << elements_vec << "[_idx];\n";
-        ss << "            g_dispatcher.remove(_old);\n";
-        ss << "            webcc::dom::remove_element(_old);\n";
+        if (row_handlers)
+            emit_row_handler_removal(ss, region, handlers_vec + "[_idx]", "            ");
+        ss << "            g_dom_writes.remove(_old);\n";
         ss << "            _ref = (_idx + 1 < (int)" << elements_vec << ".size()) ? " << elements_vec << "[_idx + 1] : " << anchor_var << ";\n";
         ss << "        }\n";
         ss << "        auto& " << region.var_name << " = " << region.iterable_expr << "[_idx];\n";
 
         std::string item_code = transform_to_insert_before(region.item_creation_code, parent_var, "_ref");
+        if (row_handlers)
+            ss << "        coi::vector<webcc::handle> _row_handlers;\n";
         ss << indent_code(item_code, "        ");
+        if (row_handlers)
+        {
+            ss << "        if (_idx < (int)" << handlers_vec << ".size()) " << handlers_vec << "[_idx] = _row_handlers;\n";
+            ss << "        else " << handlers_vec << ".push_back(_row_handlers);\n";
+        }
         ss << "        if (_idx < (int)" << elements_vec << ".size()) " << elements_vec << "[_idx] = " << region.root_element_var << ";\n";
         ss << "        else " << elements_vec << ".push_back(" << region.root_element_var << ");\n";
         ss << "    }\n";
@@ -1058,225 +1505,24 @@ std::string Component::to_webcc(CompilerSession &session)
     // Generate _sync_if_X() methods
     for (const auto &region : if_regions)
     {
+        if (region.keep)
+        {
+            emit_kept_if_sync(ss, region, if_regions, event_handlers, kept_branch_updates[{region.if_id, true}],
+                              kept_branch_updates[{region.if_id, false}]);
+            continue;
+        }
         ss << "    void _sync_if_" << region.if_id << "() {\n";
         ss << "        bool new_state = " << region.condition_code << ";\n";
         ss << "        if (new_state == _if_" << region.if_id << "_state) return;\n";
         ss << "        _if_" << region.if_id << "_state = new_state;\n";
         ss << "        \n";
 
-        std::set<int> click_els = get_elements_for_event(event_handlers, "click");
-        std::set<int> input_els = get_elements_for_event(event_handlers, "input");
-        std::set<int> change_els = get_elements_for_event(event_handlers, "change");
-        std::set<int> keydown_els = get_elements_for_event(event_handlers, "keydown");
-
-        // Build sets of element IDs owned by nested ifs (to exclude from unconditional removal)
-        std::set<int> else_nested_if_els;
-        for (int nested_if_id : region.else_if_ids)
-        {
-            for (const auto &nested_region : if_regions)
-            {
-                if (nested_region.if_id == nested_if_id)
-                {
-                    else_nested_if_els.insert(nested_region.then_element_ids.begin(), nested_region.then_element_ids.end());
-                    else_nested_if_els.insert(nested_region.else_element_ids.begin(), nested_region.else_element_ids.end());
-                }
-            }
-        }
-        std::set<int> then_nested_if_els;
-        for (int nested_if_id : region.then_if_ids)
-        {
-            for (const auto &nested_region : if_regions)
-            {
-                if (nested_region.if_id == nested_if_id)
-                {
-                    then_nested_if_els.insert(nested_region.then_element_ids.begin(), nested_region.then_element_ids.end());
-                    then_nested_if_els.insert(nested_region.else_element_ids.begin(), nested_region.else_element_ids.end());
-                }
-            }
-        }
-
         ss << "        if (new_state) {\n";
-        for (int el_id : region.else_element_ids)
-        {
-            if (else_nested_if_els.count(el_id))
-                continue; // Handled by nested-if conditional removal below
-            if (click_els.count(el_id))
-                ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-            if (input_els.count(el_id))
-                ss << "            g_input_dispatcher.remove(el[" << el_id << "]);\n";
-            if (change_els.count(el_id))
-                ss << "            g_change_dispatcher.remove(el[" << el_id << "]);\n";
-            if (keydown_els.count(el_id))
-                ss << "            g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-        }
-        for (int el_id : region.else_element_ids)
-        {
-            if (else_nested_if_els.count(el_id))
-                continue; // Handled by nested-if conditional removal below
-            ss << "            webcc::dom::remove_element(el[" << el_id << "]);\n";
-        }
-        for (const auto &[comp_name, inst_id] : region.else_components)
-        {
-            ss << "            " << comp_name << "_" << inst_id << "._destroy();\n";
-        }
-        // Remove view from member references (keeps component state, just removes DOM)
-        for (const auto &member_name : region.else_member_refs)
-        {
-            ss << "            " << member_name << "._remove_view();\n";
-        }
-        for (int loop_id : region.else_loop_ids)
-        {
-            for (const auto &lr : loop_regions)
-            {
-                if (lr.loop_id == loop_id)
-                {
-                    if (!lr.component_type.empty())
-                    {
-                        std::string vec_name = "_loop_" + lr.component_type + "s";
-                        ss << "            while ((int)" << vec_name << ".size() > 0) {\n";
-                        ss << "                " << vec_name << "[" << vec_name << ".size() - 1]._destroy();\n";
-                        ss << "                " << vec_name << ".pop_back();\n";
-                        ss << "            }\n";
-                        ss << "            _loop_" << loop_id << "_count = 0;\n";
-                    }
-                    else if (lr.is_html_loop)
-                    {
-                        std::string vec_name = "_loop_" + std::to_string(loop_id) + "_elements";
-                        ss << "            while ((int)" << vec_name << ".size() > 0) {\n";
-                        ss << "                webcc::dom::remove_element(" << vec_name << "[" << vec_name << ".size() - 1]);\n";
-                        ss << "                " << vec_name << ".pop_back();\n";
-                        ss << "            }\n";
-                        ss << "            _loop_" << loop_id << "_count = 0;\n";
-                    }
-                    break;
-                }
-            }
-        }
-        for (int nested_if_id : region.else_if_ids)
-        {
-            for (const auto &nested_region : if_regions)
-            {
-                if (nested_region.if_id == nested_if_id)
-                {
-                    for (int el_id : nested_region.then_element_ids)
-                    {
-                        if (click_els.count(el_id))
-                            ss << "            if (_if_" << nested_if_id << "_state) g_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (input_els.count(el_id))
-                            ss << "            if (_if_" << nested_if_id << "_state) g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (change_els.count(el_id))
-                            ss << "            if (_if_" << nested_if_id << "_state) g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (keydown_els.count(el_id))
-                            ss << "            if (_if_" << nested_if_id << "_state) g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-                        ss << "            if (_if_" << nested_if_id << "_state) webcc::dom::remove_element(el[" << el_id << "]);\n";
-                    }
-                    for (int el_id : nested_region.else_element_ids)
-                    {
-                        if (click_els.count(el_id))
-                            ss << "            if (!_if_" << nested_if_id << "_state) g_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (input_els.count(el_id))
-                            ss << "            if (!_if_" << nested_if_id << "_state) g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (change_els.count(el_id))
-                            ss << "            if (!_if_" << nested_if_id << "_state) g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (keydown_els.count(el_id))
-                            ss << "            if (!_if_" << nested_if_id << "_state) g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-                        ss << "            if (!_if_" << nested_if_id << "_state) webcc::dom::remove_element(el[" << el_id << "]);\n";
-                    }
-                }
-            }
-        }
+        emit_branch_teardown(ss, region, false, if_regions, loop_regions, event_handlers);
         ss << region.then_creation_code;
 
         ss << "        } else {\n";
-        for (int el_id : region.then_element_ids)
-        {
-            if (then_nested_if_els.count(el_id))
-                continue; // Handled by nested-if conditional removal below
-            if (click_els.count(el_id))
-                ss << "            g_dispatcher.remove(el[" << el_id << "]);\n";
-            if (input_els.count(el_id))
-                ss << "            g_input_dispatcher.remove(el[" << el_id << "]);\n";
-            if (change_els.count(el_id))
-                ss << "            g_change_dispatcher.remove(el[" << el_id << "]);\n";
-            if (keydown_els.count(el_id))
-                ss << "            g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-        }
-        for (int el_id : region.then_element_ids)
-        {
-            if (then_nested_if_els.count(el_id))
-                continue; // Handled by nested-if conditional removal below
-            ss << "            webcc::dom::remove_element(el[" << el_id << "]);\n";
-        }
-        for (const auto &[comp_name, inst_id] : region.then_components)
-        {
-            ss << "            " << comp_name << "_" << inst_id << "._destroy();\n";
-        }
-        // Remove view from member references (keeps component state, just removes DOM)
-        for (const auto &member_name : region.then_member_refs)
-        {
-            ss << "            " << member_name << "._remove_view();\n";
-        }
-        for (int loop_id : region.then_loop_ids)
-        {
-            for (const auto &lr : loop_regions)
-            {
-                if (lr.loop_id == loop_id)
-                {
-                    if (!lr.component_type.empty())
-                    {
-                        std::string vec_name = "_loop_" + lr.component_type + "s";
-                        ss << "            while ((int)" << vec_name << ".size() > 0) {\n";
-                        ss << "                " << vec_name << "[" << vec_name << ".size() - 1]._destroy();\n";
-                        ss << "                " << vec_name << ".pop_back();\n";
-                        ss << "            }\n";
-                        ss << "            _loop_" << loop_id << "_count = 0;\n";
-                    }
-                    else if (lr.is_html_loop)
-                    {
-                        std::string vec_name = "_loop_" + std::to_string(loop_id) + "_elements";
-                        ss << "            while ((int)" << vec_name << ".size() > 0) {\n";
-                        ss << "                webcc::dom::remove_element(" << vec_name << "[" << vec_name << ".size() - 1]);\n";
-                        ss << "                " << vec_name << ".pop_back();\n";
-                        ss << "            }\n";
-                        ss << "            _loop_" << loop_id << "_count = 0;\n";
-                    }
-                    break;
-                }
-            }
-        }
-        for (int nested_if_id : region.then_if_ids)
-        {
-            for (const auto &nested_region : if_regions)
-            {
-                if (nested_region.if_id == nested_if_id)
-                {
-                    for (int el_id : nested_region.then_element_ids)
-                    {
-                        if (click_els.count(el_id))
-                            ss << "            if (_if_" << nested_if_id << "_state) g_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (input_els.count(el_id))
-                            ss << "            if (_if_" << nested_if_id << "_state) g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (change_els.count(el_id))
-                            ss << "            if (_if_" << nested_if_id << "_state) g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (keydown_els.count(el_id))
-                            ss << "            if (_if_" << nested_if_id << "_state) g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-                        ss << "            if (_if_" << nested_if_id << "_state) webcc::dom::remove_element(el[" << el_id << "]);\n";
-                    }
-                    for (int el_id : nested_region.else_element_ids)
-                    {
-                        if (click_els.count(el_id))
-                            ss << "            if (!_if_" << nested_if_id << "_state) g_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (input_els.count(el_id))
-                            ss << "            if (!_if_" << nested_if_id << "_state) g_input_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (change_els.count(el_id))
-                            ss << "            if (!_if_" << nested_if_id << "_state) g_change_dispatcher.remove(el[" << el_id << "]);\n";
-                        if (keydown_els.count(el_id))
-                            ss << "            if (!_if_" << nested_if_id << "_state) g_keydown_dispatcher.remove(el[" << el_id << "]);\n";
-                        ss << "            if (!_if_" << nested_if_id << "_state) webcc::dom::remove_element(el[" << el_id << "]);\n";
-                    }
-                }
-            }
-        }
+        emit_branch_teardown(ss, region, true, if_regions, loop_regions, event_handlers);
         if (!region.else_creation_code.empty())
         {
             ss << region.else_creation_code;
@@ -1298,14 +1544,10 @@ std::string Component::to_webcc(CompilerSession &session)
         collect_child_updates(root.get(), child_updates, update_counters);
     }
 
-    // Helper lambda for method generation
-    auto generate_method = [&](FunctionDef &method)
+    // Build the update calls that follow a change to the given variables
+    auto build_updates = [&](const std::set<std::string> &modified_vars, bool is_init_method)
     {
-        std::set<std::string> modified_vars;
-        method.collect_modifications(modified_vars);
-
         std::string updates;
-        bool is_init_method = (method.name == "init");
         for (const auto &mod : modified_vars)
         {
             if (generated_updaters.count(mod) && !is_init_method)
@@ -1349,6 +1591,121 @@ std::string Component::to_webcc(CompilerSession &session)
                 updates += "        if(" + callback_name + ") " + callback_name + "();\n";
             }
         }
+        return updates;
+    };
+
+    // Computed members: cached getter, plus an invalidation entry point for changes that do not
+    // come from one of this component's methods (params set by the parent, child pub members)
+    for (auto &var : state)
+    {
+        if (!var->is_computed)
+            continue;
+        std::string type = convert_type(resolve_component_type(var->type));
+        ss << "    const " << type << "& _computed_" << var->name << "() {\n";
+        ss << "        if (_computed_" << var->name << "_dirty) {\n";
+        ss << "            _computed_" << var->name << "_value = " << var->initializer->to_webcc() << ";\n";
+        ss << "            _computed_" << var->name << "_dirty = false;\n";
+        ss << "        }\n";
+        ss << "        return _computed_" << var->name << "_value;\n";
+        ss << "    }\n";
+
+        std::set<std::string> invalidated = {var->name};
+        for (const auto &name : affected_computed(invalidated))
+        {
+            invalidated.insert(name);
+        }
+        ss << "    void _invalidate_" << var->name << "() {\n";
+        for (const auto &name : invalidated)
+        {
+            ss << "        _computed_" << name << "_dirty = true;\n";
+        }
+        ss << build_updates(invalidated, false);
+        ss << "    }\n";
+    }
+
+    // Modification summaries across the component's call graph: a method's summary is what it
+    // modifies itself plus the summaries of the helpers it calls. Helpers called from other methods
+    // get a no-update body (_<name>_inner) that those callers use, so the update cascade runs once,
+    // at the outermost entry point (handler, lifecycle method, callback or external call).
+    std::map<std::string, FunctionDef *> methods_by_name;
+    for (auto &m : methods)
+    {
+        methods_by_name[m.name] = &m;
+    }
+    std::map<std::string, std::set<std::string>> method_callees;
+    std::map<std::string, std::set<std::string>> method_summaries;
+    std::set<std::string> deferred_methods;
+    for (auto &m : methods)
+    {
+        std::set<std::string> calls;
+        for (auto &stmt : m.body)
+        {
+            collect_calls_recursive(stmt.get(), calls);
+        }
+        for (const auto &callee : calls)
+        {
+            auto it = methods_by_name.find(callee);
+            // Async flows inject their own updates at each suspension point
+            if (it == methods_by_name.end() || it->second->is_async)
+                continue;
+            method_callees[m.name].insert(callee);
+            if (it->second->type_params.empty() && callee != "init" && callee != "mount" && callee != "tick")
+            {
+                deferred_methods.insert(callee);
+            }
+        }
+        m.collect_modifications(method_summaries[m.name]);
+    }
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (auto &[name, callees] : method_callees)
+        {
+            auto &summary = method_summaries[name];
+            size_t before = summary.size();
+            for (const auto &callee : callees)
+            {
+                summary.insert(method_summaries[callee].begin(), method_summaries[callee].end());
+            }
+            changed |= summary.size() != before;
+        }
+    }
+
+    // Update code injected after each method's body
+    std::map<std::string, std::string> method_updates;
+    for (auto &method : methods)
+    {
+        std::set<std::string> modified_vars = method_summaries[method.name];
+        bool is_init_method = (method.name == "init");
+
+        // Affected computed members were marked dirty by the statements modifying their inputs
+        // (see computed_invalidation); each one is refreshed once by the first binding that reads
+        // it. Computed members reading a modified param are updated through _update_<param>().
+        for (const auto &name : affected_computed(modified_vars))
+        {
+            bool via_param = false;
+            for (const auto &dep : computed_deps[name])
+            {
+                via_param |= param_names.count(dep) && modified_vars.count(dep);
+            }
+            if (via_param && !is_init_method)
+                continue;
+            modified_vars.insert(name);
+        }
+
+        method_updates[method.name] = build_updates(modified_vars, is_init_method);
+    }
+
+    // Helpers without updates need no separate body
+    for (auto it = deferred_methods.begin(); it != deferred_methods.end();)
+    {
+        it = method_updates[*it].empty() ? deferred_methods.erase(it) : std::next(it);
+    }
+
+    // Helper lambda for method generation
+    auto generate_method = [&](FunctionDef &method)
+    {
+        const std::string &updates = method_updates[method.name];
 
         std::string original_name = method.name;
         if (method.name == "tick")
@@ -1363,18 +1720,78 @@ std::string Component::to_webcc(CompilerSession &session)
         {
             method.name = "_user_mount";
         }
-        ss << "    " << method.to_webcc(updates);
+        if (deferred_methods.count(original_name))
+        {
+            // Body without updates for calls from other methods, plus an entry point that runs
+            // the summary's updates once after it
+            method.name = "_" + original_name + "_inner";
+            ss << "    " << method.to_webcc();
+            method.name = original_name;
+
+            std::string ret_type = convert_type(method.return_type);
+            std::string args;
+            ss << "    " << ret_type << " " << method.name << "(";
+            for (size_t i = 0; i < method.params.size(); i++)
+            {
+                const auto &param = method.params[i];
+                if (i > 0)
+                {
+                    ss << ", ";
+                    args += ", ";
+                }
+                if (param.is_reference)
+                {
+                    ss << (param.is_mutable ? "" : "const ") << convert_type(param.type) << "& " << param.name;
+                    args += param.name;
+                }
+                else if (param.is_mutable)
+                {
+                    ss << convert_type(param.type) << " " << param.name;
+                    args += "coi::move(" + param.name + ")";
+                }
+                else
+                {
+                    ss << "const " << convert_type(param.type) << "& " << param.name;
+                    args += param.name;
+                }
+            }
+            ss << ") {\n";
+            if (ret_type == "void")
+            {
+                ss << "        _" << method.name << "_inner(" << args << ");\n";
+                ss << updates;
+            }
+            else
+            {
+                ss << "        auto _result = _" << method.name << "_inner(" << args << ");\n";
+                ss << updates;
+                ss << "        return _result;\n";
+            }
+            ss << "    }\n";
+            return;
+        }
+        ss << "    " << (method.is_async ? method.to_webcc_async(updates) : method.to_webcc(updates));
         if (original_name == "tick" || original_name == "init" || original_name == "mount")
         {
             method.name = original_name;
         }
     };
 
-    // All methods
+    // All methods (calls between them use the deferred-update bodies)
+    // Each method is a tree-shaking region, dropped when nothing kept calls it
+    g_deferred_update_methods = deferred_methods;
     for (auto &method : methods)
     {
+        std::string symbol = method.name;
+        if (method.name == "tick" || method.name == "init" || method.name == "mount")
+        {
+            symbol = "_user_" + method.name;
+        }
+        ss << shake_region_begin({symbol, "_" + method.name + "_inner"});
         generate_method(method);
+        ss << shake_region_end();
     }
+    g_deferred_update_methods.clear();
 
     auto emit_member_dependency_callbacks = [&]() {
         for (const auto &[mem_dep, methods] : member_dep_update_methods)
@@ -1407,45 +1824,75 @@ std::string Component::to_webcc(CompilerSession &session)
     // Event handlers
     for (auto &handler : event_handlers)
     {
-        if (handler.event_type == "click")
+        std::string params;
+        std::string arg;
+        std::string value_type;
+        std::string dispatcher = "g_dispatcher";
+        if (handler.event_type == "input" || handler.event_type == "change")
         {
-            ss << "    void _handler_" << handler.element_id << "_click() {\n";
-            if (handler.is_function_call)
-            {
-                ss << "        " << handler.handler_code << ";\n";
-            }
-            else
-            {
-                ss << "        " << handler.handler_code << "();\n";
-            }
-            ss << "    }\n";
+            params = "const coi::string& _value";
+            arg = "_value";
+            value_type = "coi::string";
+            dispatcher = "g_" + handler.event_type + "_dispatcher";
         }
-        else if (handler.event_type == "input" || handler.event_type == "change")
+        else if (handler.event_type == "keydown")
         {
-            ss << "    void _handler_" << handler.element_id << "_" << handler.event_type << "(const coi::string& _value) {\n";
-            if (handler.is_function_call)
-            {
-                ss << "        " << handler.handler_code << ";\n";
-            }
-            else
-            {
-                ss << "        " << handler.handler_code << "(_value);\n";
-            }
-            ss << "    }\n";
+            params = "int _keycode";
+            arg = "_keycode";
+            value_type = "int";
+            dispatcher = "g_keydown_dispatcher";
         }
-        else if (handler.event_type == "keydown")
+        std::string call = handler.is_function_call ? handler.handler_code : handler.handler_code + "(" + arg + ")";
+        std::string handler_name = "_handler_" + std::to_string(handler.element_id) + "_" + handler.event_type;
+
+        if (handler.rate_limit.empty())
         {
-            ss << "    void _handler_" << handler.element_id << "_keydown(int _keycode) {\n";
-            if (handler.is_function_call)
-            {
-                ss << "        " << handler.handler_code << ";\n";
-            }
-            else
-            {
-                ss << "        " << handler.handler_code << "(_keycode);\n";
-            }
+            ss << "    void " << handler_name << "(" << params << ") {\n";
+            ss << "        " << call << ";\n";
             ss << "    }\n";
+            continue;
+        }
+
+        // Rate-limited handler: the dispatcher entry records the latest event and a keyed
+        // timer (run from update_wrapper) fires the user handler. The timer re-checks the
+        // dispatcher entry so a pending fire is dropped once the element is torn down.
+        std::string rate = "_rate_" + std::to_string(handler.element_id) + "_" + handler.event_type;
+        std::string el = "el[" + std::to_string(handler.element_id) + "]";
+        std::string alive = dispatcher + ".contains(h)";
+        if (!value_type.empty())
+        {
+            ss << "    " << value_type << " " << rate << "_value;\n";
+        }
+        ss << "    bool " << rate << "_pending = false;\n";
+        ss << "    void " << handler_name << "(" << params << ") {\n";
+        if (!value_type.empty())
+        {
+            ss << "        " << rate << "_value = " << arg << ";\n";
         }
+        if (handler.rate_limit == "debounce")
+        {
+            ss << "        g_timers.set(&" << rate << "_pending, " << handler.rate_ms << ", [this, h = " << el
+               << "](const coi::string&) { if (" << alive << ") " << rate << "_fire(); }, this);\n";
+        }
+        else
+        {
+            ss << "        if (g_timers.has(&" << rate << "_pending)) { " << rate << "_pending = true; return; }\n";
+            ss << "        " << rate << "_fire();\n";
+        }
+        ss << "    }\n";
+        ss << "    void " << rate << "_fire() {\n";
+        if (handler.rate_limit == "throttle")
+        {
+            ss << "        " << rate << "_pending = false;\n";
+            ss << "        g_timers.set(&" << rate << "_pending, " << handler.rate_ms << ", [this, h = " << el
+               << "](const coi::string&) { if (" << alive << " && " << rate << "_pending) " << rate << "_fire(); }, this);\n";
+        }
+        if (!value_type.empty())
+        {
+            ss << "        const " << value_type << "& " << arg << " = " << rate << "_value;\n";
+        }
+        ss << "        " << call << ";\n";
+        ss << "    }\n";
     }
 
     // View method
@@ -1468,9 +1915,9 @@ std::string Component::to_webcc(CompilerSession &session)
         ss << ss_render.str();
     }
     // End view - flushes only at outermost level, then register event handlers
-    ss << "        if (--g_view_depth == 0) webcc::flush();\n";
+    ss << "        if (--g_view_depth == 0) g_dom_writes.flush();\n";
     // Register event handlers
-    emit_all_event_registrations(ss, element_count, event_handlers, masks);
+    emit_all_event_registrations(ss, element_count, event_handlers, masks, has_keep);
 
     // Wire up onChange callbacks for child component pub mut members (in if conditions)
     for (const auto &region : if_regions)
@@ -1504,13 +1951,15 @@ std::string Component::to_webcc(CompilerSession &session)
         ss << "        if (!_route_matched) _current_route = \"" << (router->routes.empty() ? "/" : router->routes[0].path) << "\";\n";
         ss << "        _sync_route();\n";
     }
+    if (g_debug_build)
+        ss << "        _mem.update(true, _measure_memory());\n";
     ss << "    }\n";
 
     // Rebind method (always generated, even if empty, for component array reallocation)
     ss << "    void _rebind() {\n";
     if (!event_handlers.empty())
     {
-        emit_all_event_registrations(ss, element_count, event_handlers, masks);
+        emit_all_event_registrations(ss, element_count, event_handlers, masks, has_keep);
     }
 
     // Re-wire nested component reactivity after reallocation
@@ -1523,11 +1972,73 @@ std::string Component::to_webcc(CompilerSession &session)
 
     emit_component_router_methods(ss, *this);
 
-    emit_component_lifecycle_methods(ss, session, *this, masks, if_regions, element_count, component_members);
+    emit_component_lifecycle_methods(ss, session, *this, if_regions, element_count, component_members, lazy_members,
+                                     loop_regions);
+
+    // Debug builds: instance tracking (kept as the last data member so aggregate
+    // initialization of params is unchanged) and an estimate of the heap bytes owned
+    if (g_debug_build)
+    {
+        std::string qname = qualified_name(module_name, name);
+        ss << "    static constexpr const char* _component_name() { return \"" << qname << "\"; }\n";
+        // Child components report their own size (sizeof included), so a child held by value is
+        // taken out of sizeof(*this) and a vector of children is not counted here at all
+        auto measure_member = [&](const std::string &member, const std::string &type)
+        {
+            std::string base = type;
+            bool dynamic_array = base.ends_with("[]");
+            size_t bracket = base.find('[');
+            if (bracket != std::string::npos)
+                base = base.substr(0, bracket);
+            if (!session.component_info.count(resolve_component_type(base)))
+                ss << "        n += __coi_mem::owned_bytes(" << member << ");\n";
+            else if (!dynamic_array)
+                ss << "        n -= sizeof(" << member << ");\n";
+        };
+        ss << "    uint32_t _measure_memory() {\n";
+        ss << "        uint32_t n = sizeof(*this);\n";
+        for (auto &param : params)
+        {
+            if (!param->is_reference)
+                measure_member(param->name, param->type);
+        }
+        for (auto &var : state)
+        {
+            if (var->is_computed)
+                ss << "        n += __coi_mem::owned_bytes(_computed_" << var->name << "_value);\n";
+            else if (!var->is_reference)
+                measure_member(var->name, var->type);
+        }
+        for (const auto &[comp_name, count] : component_members)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                std::string member = comp_name + "_" + std::to_string(i);
+                if (!lazy_members.count(member))
+                    ss << "        n -= sizeof(" << member << ");\n";
+            }
+        }
+        for (const auto &region : loop_regions)
+        {
+            if (region.is_html_loop)
+                ss << "        n += __coi_mem::owned_bytes(_loop_" << region.loop_id << "_elements);\n";
+            if (!region.row_dispatchers.empty())
+                ss << "        n += __coi_mem::owned_bytes(_loop_" << region.loop_id << "_handlers);\n";
+        }
+        if (router)
+            ss << "        n += __coi_mem::owned_bytes(_current_route);\n";
+        if (!event_handlers.empty())
+            ss << "        n += " << event_handlers.size() << " * __coi_mem::DISPATCHER_ENTRY_BYTES;\n";
+        ss << "        return n;\n";
+        ss << "    }\n";
+        ss << "    __coi_mem::InstanceTracker<" << qname << "> _mem;\n";
+    }
 
     ss << "};\n";
 
     g_ref_props.clear();
+    g_computed_members.clear();
+    g_computed_dependents.clear();
     ComponentTypeContext::instance().clear();
 
     return ss.str();
@@ -29,18 +29,24 @@ void Component::collect_child_components(ASTNode *node, std::map<std::string, in
     }
 }
 
-void Component::collect_child_updates(ASTNode *node, std::map<std::string, std::vector<std::string>> &updates, std::map<std::string, int> &counters)
+void Component::collect_child_updates(ASTNode *node, std::map<std::string, std::vector<std::string>> &updates, std::map<std::string, int> &counters, bool in_if_branch)
 {
     if (auto comp = dynamic_cast<ComponentInstantiation *>(node))
     {
         std::string instance_name;
+        std::string update_prefix;
         if (comp->is_member_reference)
         {
             instance_name = comp->member_name;
+            update_prefix = "        " + instance_name + ".";
         }
         else
         {
-            instance_name = comp->component_name + "_" + std::to_string(counters[comp->component_name]++);
+            std::string qname = qualified_name(comp->module_prefix, comp->component_name);
+            instance_name = qname + "_" + std::to_string(counters[qname]++);
+            // If-branch children only exist while their branch is shown
+            update_prefix = in_if_branch ? "        if (" + instance_name + ") " + instance_name + "->"
+                                         : "        " + instance_name + ".";
         }
 
         for (const auto &prop : comp->props)
@@ -51,7 +57,7 @@ void Component::collect_child_updates(ASTNode *node, std::map<std::string, std::
                 prop.value->collect_dependencies(deps);
                 for (const auto &dep : deps)
                 {
-                    updates[dep].push_back("        " + instance_name + "._update_" + prop.name + "();\n");
+                    updates[dep].push_back(update_prefix + "_update_" + prop.name + "();\n");
                 }
             }
         }
@@ -60,18 +66,18 @@ void Component::collect_child_updates(ASTNode *node, std::map<std::string, std::
     {
         for (auto &child : el->children)
         {
-            collect_child_updates(child.get(), updates, counters);
+            collect_child_updates(child.get(), updates, counters, in_if_branch);
         }
     }
     if (auto viewIf = dynamic_cast<ViewIfStatement *>(node))
     {
         for (auto &child : viewIf->then_children)
         {
-            collect_child_updates(child.get(), updates, counters);
+            collect_child_updates(child.get(), updates, counters, true);
         }
         for (auto &child : viewIf->else_children)
         {
-            collect_child_updates(child.get(), updates, counters);
+            collect_child_updates(child.get(), updates, counters, true);
         }
     }
 }
@@ -1,5 +1,7 @@
 #include "definitions.h"
 #include "node.h"
+#include "codegen_state.h"
+#include "../cli/error.h"
 
 std::string FunctionDef::to_webcc(const std::string& injected_code) {
     ComponentTypeContext::instance().begin_method_scope();
@@ -29,7 +31,7 @@ std::string FunctionDef::to_webcc(const std::string& injected_code) {
     
     result += ") {\n";
     for(auto& stmt : body){
-        result += "    " + stmt->to_webcc() + "\n";
+        result += "    " + statement_code(stmt.get()) + "\n";
     }
     if(!injected_code.empty()) {
         result += injected_code;
@@ -40,6 +42,151 @@ std::string FunctionDef::to_webcc(const std::string& injected_code) {
     return result;
 }
 
+// Returns the awaited expression if stmt is a suspension point of an async def body:
+//   await op;  |  Type name = await op;  |  name = await op;
+static AwaitExpr* get_statement_await(Statement* stmt) {
+    if (auto* expr_stmt = dynamic_cast<ExpressionStatement*>(stmt)) {
+        return dynamic_cast<AwaitExpr*>(expr_stmt->expression.get());
+    }
+    if (auto* decl = dynamic_cast<VarDeclaration*>(stmt)) {
+        return dynamic_cast<AwaitExpr*>(decl->initializer.get());
+    }
+    if (auto* assign = dynamic_cast<Assignment*>(stmt)) {
+        return dynamic_cast<AwaitExpr*>(assign->value.get());
+    }
+    return nullptr;
+}
+
+std::string FunctionDef::to_webcc_async(const std::string& injected_code) {
+    // Split the body into segments that each end at an await (the last one runs to completion)
+    std::vector<std::vector<Statement*>> segments(1);
+    for (auto& stmt : body) {
+        segments.back().push_back(stmt.get());
+        if (get_statement_await(stmt.get())) {
+            segments.emplace_back();
+        }
+    }
+    if (segments.size() == 1) {
+        return to_webcc(injected_code);
+    }
+
+    ComponentTypeContext::instance().begin_method_scope();
+
+    std::string frame = "_async_" + name;
+    std::string resume = frame + "_resume";
+
+    // Parameters and every local declared before the last await live in the frame,
+    // so state survives suspension without heap-allocated closures.
+    std::vector<std::pair<std::string, std::string>> frame_fields;
+    for (const auto& param : params) {
+        if (param.is_reference) {
+            ErrorHandler::compiler_error("async def '" + name + "' cannot take reference parameter '" + param.name + "'");
+        }
+        frame_fields.push_back({convert_type(param.type), param.name});
+        ComponentTypeContext::instance().set_method_symbol_type(param.name, param.type);
+    }
+    std::set<Statement*> hoisted;
+    for (size_t seg = 0; seg + 1 < segments.size(); seg++) {
+        for (auto* stmt : segments[seg]) {
+            auto* decl = dynamic_cast<VarDeclaration*>(stmt);
+            if (!decl) continue;
+            if (decl->is_reference) {
+                ErrorHandler::compiler_error("Reference '" + decl->name + "' cannot live across an await in async def '" + name + "'", decl->line);
+            }
+            if (dynamic_cast<ArrayLiteral*>(decl->initializer.get()) || dynamic_cast<ArrayRepeatLiteral*>(decl->initializer.get())) {
+                ErrorHandler::compiler_error("Array literal '" + decl->name + "' cannot live across an await in async def '" + name +
+                    "'. Declare it after the last await or store it in component state", decl->line);
+            }
+            frame_fields.push_back({convert_type(decl->type), decl->name});
+            hoisted.insert(stmt);
+        }
+    }
+
+    std::string result;
+    result += "struct " + frame + "_frame {\n";
+    result += "        int _gen = 0;\n";
+    for (const auto& [type, field] : frame_fields) {
+        result += "        " + type + " " + field + ";\n";
+    }
+    result += "    } " + frame + ";\n";
+
+    // Entry point: restarting the flow bumps the generation so stale resumes are dropped
+    result += "    void " + name + "(";
+    for (size_t i = 0; i < params.size(); i++) {
+        if (i > 0) result += ", ";
+        result += (params[i].is_mutable ? "" : "const ") + convert_type(params[i].type) + " " + params[i].name;
+    }
+    result += ") {\n";
+    for (const auto& param : params) {
+        result += "        " + frame + "." + param.name + " = " + param.name + ";\n";
+    }
+    result += "        " + resume + "(++" + frame + "._gen, 0, coi::string());\n";
+    result += "    }\n";
+
+    result += "    void " + resume + "(int _gen, int _state, const coi::string& _result) {\n";
+    result += "        if (_gen != " + frame + "._gen) return;\n";
+    for (const auto& [type, field] : frame_fields) {
+        result += "        auto& " + field + " = " + frame + "." + field + ";\n";
+    }
+    result += "        switch (_state) {\n";
+    for (size_t seg = 0; seg < segments.size(); seg++) {
+        result += "        case " + std::to_string(seg) + ": {\n";
+
+        // Deliver the result of the await that ended the previous segment
+        if (seg > 0) {
+            Statement* prev = segments[seg - 1].back();
+            if (auto* decl = dynamic_cast<VarDeclaration*>(prev)) {
+                result += "            " + decl->name + " = _result;\n";
+            } else if (auto* assign = dynamic_cast<Assignment*>(prev)) {
+                std::string lhs = g_ref_props.count(assign->name) ? "(*" + assign->name + ")" : assign->name;
+                result += "            " + lhs + " = _result;" + computed_invalidation(assign) + "\n";
+            }
+        }
+
+        for (auto* stmt : segments[seg]) {
+            if (AwaitExpr* await_expr = get_statement_await(stmt)) {
+                if (auto* decl = dynamic_cast<VarDeclaration*>(stmt)) {
+                    ComponentTypeContext::instance().set_method_symbol_type(decl->name, decl->type);
+                }
+                std::string callback = "[this, _gen](const coi::string& _r) { this->" + resume + "(_gen, " +
+                                       std::to_string(seg + 1) + ", _r); }";
+                result += "            " + await_expr->to_webcc_suspend(callback) + "\n";
+                continue;
+            }
+            if (hoisted.count(stmt)) {
+                auto* decl = static_cast<VarDeclaration*>(stmt);
+                ComponentTypeContext::instance().set_method_symbol_type(decl->name, decl->type);
+                if (!decl->initializer) {
+                    result += "            " + decl->name + " = " + convert_type(decl->type) + "();\n";
+                    continue;
+                }
+                // Reuse assignment lowering (handle casts, moves) for the hoisted initializer
+                Assignment assign;
+                assign.name = decl->name;
+                assign.target_type = decl->type;
+                assign.is_move = decl->is_move;
+                assign.value = std::move(decl->initializer);
+                result += "            " + assign.to_webcc() + "\n";
+                decl->initializer = std::move(assign.value);
+                continue;
+            }
+            result += "            " + statement_code(stmt) + "\n";
+        }
+
+        if (seg + 1 < segments.size()) {
+            result += injected_code;
+            result += "            return;\n";
+        }
+        result += "        }\n";
+    }
+    result += "        }\n";
+    result += injected_code;
+    result += "    }\n";
+
+    ComponentTypeContext::instance().end_method_scope();
+    return result;
+}
+
 void FunctionDef::collect_modifications(std::set<std::string>& mods) const {
     for(const auto& stmt : body) {
         collect_mods_recursive(stmt.get(), mods);
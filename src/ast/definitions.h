@@ -7,6 +7,7 @@ struct FunctionDef {
     std::string name;
     std::string return_type;
     bool is_public = false;
+    bool is_async = false;  // async def: body is lowered to a resumable state machine
     std::vector<std::string> type_params;  // Generic type parameters (e.g., ["T"] or ["A", "B"])
     struct Param {
         std::string type;
@@ -18,6 +19,9 @@ struct FunctionDef {
     std::vector<std::unique_ptr<Statement>> body;
 
     std::string to_webcc(const std::string& injected_code = "");
+    // Lower an async def: frame struct, entry method and _async_<name>_resume state machine.
+    // injected_code runs before every suspension and at the end of the body.
+    std::string to_webcc_async(const std::string& injected_code = "");
     void collect_modifications(std::set<std::string>& mods) const;
 };
 
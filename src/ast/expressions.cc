@@ -202,18 +202,18 @@ static std::string generate_ws_dispatcher(const std::string& event_type,
     if (event_type == "onMessage") {
         // onMessage can accept 0 or 1 (string) param
         if (param_count >= 1) {
-            return "g_ws_message_dispatcher.set(" + ws_obj + ", [this](const coi::string& msg) { this->" + callback + "(msg); })";
+            return "g_ws_message_dispatcher.set(" + ws_obj + ", [this](const coi::string& msg) { this->" + callback + "(msg); }, this)";
         } else {
-            return "g_ws_message_dispatcher.set(" + ws_obj + ", [this](const coi::string&) { this->" + callback + "(); })";
+            return "g_ws_message_dispatcher.set(" + ws_obj + ", [this](const coi::string&) { this->" + callback + "(); }, this)";
         }
     } else if (event_type == "onOpen") {
-        return "g_ws_open_dispatcher.set(" + ws_obj + ", [this]() { this->" + callback + "(); })";
+        return "g_ws_open_dispatcher.set(" + ws_obj + ", [this]() { this->" + callback + "(); }, this)";
     } else if (event_type == "onClose") {
         std::string invalidate = ws_member.empty() ? "" : " this->" + ws_member + " = webcc::WebSocket(-1);";
-        return "g_ws_close_dispatcher.set(" + ws_obj + ", [this]() { this->" + callback + "();" + invalidate + " })";
+        return "g_ws_close_dispatcher.set(" + ws_obj + ", [this]() { this->" + callback + "();" + invalidate + " }, this)";
     } else if (event_type == "onError") {
         std::string invalidate = ws_member.empty() ? "" : " this->" + ws_member + " = webcc::WebSocket(-1);";
-        return "g_ws_error_dispatcher.set(" + ws_obj + ", [this]() { this->" + callback + "();" + invalidate + " })";
+        return "g_ws_error_dispatcher.set(" + ws_obj + ", [this]() { this->" + callback + "();" + invalidate + " }, this)";
     }
     return "";
 }
@@ -223,8 +223,54 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
                                       const std::vector<CallArg>& args) {
 
     if (intrinsic_name == "flush") {
-        return "webcc::flush()";
+        return "g_dom_writes.flush()";
     }                                  
+    if (intrinsic_name == "frame_used") {
+        return "(int)g_frame.frame_bytes";
+    }
+    if (intrinsic_name == "frame_high_water") {
+        return "(int)g_frame.high_water";
+    }
+    if (intrinsic_name == "frame_reserve" && args.size() == 1) {
+        return "g_frame.reserve(" + args[0].value->to_webcc() + ")";
+    }
+    // The recorder and player only exist in --record / --replay builds
+    if (intrinsic_name == "trace_save") {
+        return g_trace_record ? "g_trace.save()" : "(void)0";
+    }
+    if (intrinsic_name == "trace_frames") {
+        if (g_trace_record) return "(int)g_trace.frames";
+        return g_trace_replay ? "(int)g_replay.frames" : "0";
+    }
+    if (intrinsic_name == "trace_replaying") {
+        return g_trace_replay ? "g_replay.active()" : "false";
+    }
+    // Memory telemetry only exists in debug builds; elsewhere the queries fold to constants
+    if (intrinsic_name == "memory_instances" && args.size() == 1) {
+        return g_debug_build ? "__coi_mem::instances(" + args[0].value->to_webcc() + ")" : "0";
+    }
+    if (intrinsic_name == "memory_bytes" && args.size() == 1) {
+        return g_debug_build ? "__coi_mem::bytes(" + args[0].value->to_webcc() + ")" : "0";
+    }
+    if (intrinsic_name == "memory_dispatcher_high_water" && args.size() == 1) {
+        return g_debug_build ? "__coi_mem::dispatcher_high_water(" + args[0].value->to_webcc() + ")" : "0";
+    }
+    if (intrinsic_name == "memory_leaked_handlers") {
+        return g_debug_build ? "__coi_mem::leaked_handlers" : "0";
+    }
+    if (intrinsic_name == "memory_dump") {
+        return g_debug_build ? "__coi_mem::dump()" : "(void)0";
+    }
+    if (intrinsic_name.starts_with("heap_")) {
+        if (g_heap_allocator.empty()) {
+            ErrorHandler::compiler_error("Heap statistics need an allocator selected in the app block (allocator = \"slab\", \"tlsf\" or \"bump\")");
+        }
+        if (intrinsic_name == "heap_fragmentation") return "__coi_heap::stats.fragmentation()";
+        if (intrinsic_name == "heap_live_allocations") return "(int)__coi_heap::stats.live_allocations";
+        if (intrinsic_name == "heap_live_bytes") return "(int)__coi_heap::stats.live_bytes";
+        if (intrinsic_name == "heap_high_water") return "(int)__coi_heap::stats.high_water";
+        if (intrinsic_name == "heap_reserved") return "(int)__coi_heap::stats.reserved_bytes";
+    }
     if (intrinsic_name == "random") {
         return "webcc::random()";
     }
@@ -238,6 +284,14 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
         return "!g_key_state[" + args[0].value->to_webcc() + "]";
     }
     
+    // Timer.sleep(ms) only makes sense as a suspension point of an async def
+    if (intrinsic_name == "timer_sleep" && args.size() == 1) {
+        if (g_await_resume.empty()) {
+            ErrorHandler::compiler_error("Timer.sleep must be awaited inside an async def (await Timer.sleep(ms))");
+        }
+        return "g_timers.add(" + args[0].value->to_webcc() + ", " + g_await_resume + ", this)";
+    }
+    
     // Router navigation intrinsics
     if (intrinsic_name == "navigate" && args.size() == 1) {
         return "g_app_navigate(" + args[0].value->to_webcc() + ")";
@@ -313,6 +367,9 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
         }
 
         code += "            auto _req = webcc::fetch::get(" + url + ", " + headers + ");\n";
+        if (!g_await_resume.empty()) {
+            code += "            g_fetch_success_dispatcher.set(_req, " + g_await_resume + ", this);\n";
+        }
         
         callback_position = 0;
         for (size_t i = 1; i < args.size(); i++) {
@@ -331,15 +388,15 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
             
             if (event_name == "onSuccess") {
                 if (param_count >= 1) {
-                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string& data) { this->" + callback + "(data); });\n";
+                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string& data) { this->" + callback + "(data); }, this);\n";
                 } else {
-                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); });\n";
+                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); }, this);\n";
                 }
             } else if (event_name == "onError") {
                 if (param_count >= 1) {
-                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string& error) { this->" + callback + "(error); });\n";
+                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string& error) { this->" + callback + "(error); }, this);\n";
                 } else {
-                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); });\n";
+                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); }, this);\n";
                 }
             } else {
                 ErrorHandler::compiler_error("Invalid callback name '" + event_name + "' for fetch.get (expected onSuccess or onError)");
@@ -379,6 +436,9 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
         }
 
         code += "            auto _req = webcc::fetch::post(" + url + ", " + body + ", " + headers + ");\n";
+        if (!g_await_resume.empty()) {
+            code += "            g_fetch_success_dispatcher.set(_req, " + g_await_resume + ", this);\n";
+        }
         
         callback_position = 0;
         for (size_t i = 2; i < args.size(); i++) {
@@ -397,15 +457,15 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
             
             if (event_name == "onSuccess") {
                 if (param_count >= 1) {
-                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string& data) { this->" + callback + "(data); });\n";
+                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string& data) { this->" + callback + "(data); }, this);\n";
                 } else {
-                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); });\n";
+                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); }, this);\n";
                 }
             } else if (event_name == "onError") {
                 if (param_count >= 1) {
-                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string& error) { this->" + callback + "(error); });\n";
+                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string& error) { this->" + callback + "(error); }, this);\n";
                 } else {
-                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); });\n";
+                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); }, this);\n";
                 }
             } else {
                 ErrorHandler::compiler_error("Invalid callback name '" + event_name + "' for fetch.post (expected onSuccess or onError)");
@@ -445,6 +505,9 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
         }
 
         code += "            auto _req = webcc::fetch::patch(" + url + ", " + body + ", " + headers + ");\n";
+        if (!g_await_resume.empty()) {
+            code += "            g_fetch_success_dispatcher.set(_req, " + g_await_resume + ", this);\n";
+        }
 
         callback_position = 0;
         for (size_t i = 2; i < args.size(); i++) {
@@ -463,15 +526,15 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
 
             if (event_name == "onSuccess") {
                 if (param_count >= 1) {
-                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string& data) { this->" + callback + "(data); });\n";
+                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string& data) { this->" + callback + "(data); }, this);\n";
                 } else {
-                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); });\n";
+                    code += "            g_fetch_success_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); }, this);\n";
                 }
             } else if (event_name == "onError") {
                 if (param_count >= 1) {
-                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string& error) { this->" + callback + "(error); });\n";
+                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string& error) { this->" + callback + "(error); }, this);\n";
                 } else {
-                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); });\n";
+                    code += "            g_fetch_error_dispatcher.set(_req, [this](const coi::string&) { this->" + callback + "(); }, this);\n";
                 }
             } else {
                 ErrorHandler::compiler_error("Invalid callback name '" + event_name + "' for fetch.patch (expected onSuccess or onError)");
@@ -688,6 +751,9 @@ std::string Identifier::to_webcc() {
     if(g_ref_props.count(name)) {
         return "(*" + name + ")";
     }
+    if(g_computed_members.count(name)) {
+        return "_computed_" + name + "()";
+    }
     return name;
 }
 
@@ -855,6 +921,10 @@ std::string FunctionCall::to_webcc() {
     }
 
     if (map_method && !map_ns.empty() && !map_func.empty()) {
+        // Direct DOM calls (through element refs) run after the pending binding writes, so they read
+        // the latest values and a binding write cannot land on top of them at the next flush
+        std::string dom_commit = map_ns == "dom" ? "g_dom_writes.commit()" : "";
+
         // Check for string concat argument - use formatter block
         bool has_string_concat_arg = false;
         int string_concat_arg_idx = -1;
@@ -896,6 +966,9 @@ std::string FunctionCall::to_webcc() {
                 first_arg = false;
             }
             call_suffix += ")";
+            if (!dom_commit.empty()) {
+                call_prefix = dom_commit + "; " + call_prefix;
+            }
 
             return generate_formatter_block(parts, call_prefix, call_suffix);
         }
@@ -944,6 +1017,9 @@ std::string FunctionCall::to_webcc() {
             first_arg = false;
         }
         code += ")";
+        if (!dom_commit.empty()) {
+            code = "(" + dom_commit + ", " + code + ")";
+        }
 
         // Check return type from method definition
         if (map_method->return_type == "int") {
@@ -954,6 +1030,9 @@ std::string FunctionCall::to_webcc() {
     }
 
     std::string call_name = name;
+    if (g_deferred_update_methods.count(name)) {
+        call_name = "_" + name + "_inner";
+    }
     if (name.find('.') == std::string::npos &&
         name.find("::") == std::string::npos &&
         !name.empty() &&
@@ -1120,6 +1199,32 @@ std::string MoveExpression::to_webcc() {
     return "coi::move(" + operand->to_webcc() + ")";
 }
 
+std::string AwaitExpr::to_webcc() {
+    // Async defs lower awaits themselves; reaching here means await was used in expression position
+    ErrorHandler::compiler_error("'await' can only be used as a statement, initializer or assignment value inside an async def", line);
+}
+
+std::string AwaitExpr::to_webcc_suspend(const std::string& resume_callback) {
+    auto* call = dynamic_cast<FunctionCall*>(operand.get());
+    if (!call) {
+        ErrorHandler::compiler_error("'await' expects a call to FetchRequest.get/post/patch, Timer.sleep or WebSocket.receive", line);
+    }
+
+    // ws.receive(): one-shot resume on the socket's next message
+    size_t dot_pos = call->name.rfind('.');
+    if (dot_pos != std::string::npos && call->args.empty() && call->name.substr(dot_pos + 1) == "receive") {
+        std::string obj = call->name.substr(0, dot_pos);
+        if (ComponentTypeContext::instance().get_symbol_type(obj) == "WebSocket") {
+            return "g_ws_receive_dispatcher.set(" + obj + ", " + resume_callback + ", this);";
+        }
+    }
+
+    g_await_resume = resume_callback;
+    std::string code = call->to_webcc();
+    g_await_resume.clear();
+    return code + ";";
+}
+
 TernaryOp::TernaryOp(std::unique_ptr<Expression> cond, std::unique_ptr<Expression> t, std::unique_ptr<Expression> f)
     : condition(std::move(cond)), true_expr(std::move(t)), false_expr(std::move(f)) {}
 
@@ -1221,9 +1326,114 @@ std::vector<Expression*> ComponentConstruction::get_children() {
     return children;
 }
 
+// FNV-1a, mirrored by the hash loop emitted for string matches
+static uint32_t match_string_hash(const std::string& s) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : s) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+// Lowers a match whose arms are all enum values, int literals or plain string literals to a
+// switch. Strings switch on length, then on a hash within a length shared by several arms, with
+// one verifying compare per candidate. Returns "" when the arms need the if-chain.
+static std::string generate_match_switch(MatchExpr& match) {
+    enum class SwitchKind { None, Enum, Int, String };
+    SwitchKind kind = SwitchKind::None;
+    std::vector<std::pair<std::string, const MatchArm*>> cases;  // case key -> first arm with that key
+    std::set<std::string> seen;
+    const MatchArm* else_arm = nullptr;
+
+    for (const auto& arm : match.arms) {
+        SwitchKind arm_kind = SwitchKind::None;
+        std::string key;
+        if (arm.pattern.kind == MatchPattern::Kind::Else) {
+            if (!else_arm) else_arm = &arm;
+            continue;
+        } else if (arm.pattern.kind == MatchPattern::Kind::Enum) {
+            arm_kind = SwitchKind::Enum;
+            key = ComponentTypeContext::instance().resolve(arm.pattern.type_name) + "::" + arm.pattern.enum_value;
+        } else if (arm.pattern.kind == MatchPattern::Kind::Literal) {
+            if (auto* int_lit = dynamic_cast<IntLiteral*>(arm.pattern.literal_value.get())) {
+                arm_kind = SwitchKind::Int;
+                key = std::to_string(int_lit->value);
+            } else if (auto* str_lit = dynamic_cast<StringLiteral*>(arm.pattern.literal_value.get())) {
+                auto parts = str_lit->parse();
+                arm_kind = SwitchKind::String;
+                for (const auto& part : parts) {
+                    if (part.is_expr) arm_kind = SwitchKind::None;
+                    key += part.content;
+                }
+            }
+        }
+        if (arm_kind == SwitchKind::None || (kind != SwitchKind::None && arm_kind != kind)) return "";
+        kind = arm_kind;
+        // Later arms repeating a value are unreachable, as in the if-chain
+        if (seen.insert(key).second) cases.push_back({key, &arm});
+    }
+    if (cases.size() < 2) return "";
+
+    // Only switch on ints when the subject is known to be an integer (a float would truncate)
+    if (kind == SwitchKind::Int) {
+        auto* id = dynamic_cast<Identifier*>(match.subject.get());
+        std::string type = id ? ComponentTypeContext::instance().get_symbol_type(id->name) : "";
+        if (!(type.starts_with("int") || type.starts_with("uint")) || type.find('[') != std::string::npos) return "";
+    }
+
+    std::string code = "[&]() {\n";
+    code += "        const auto& _match_subject = " + match.subject->to_webcc() + ";\n";
+    if (kind == SwitchKind::Enum || kind == SwitchKind::Int) {
+        code += "        switch (_match_subject) {\n";
+        for (const auto& [key, arm] : cases) {
+            code += "        case " + key + ":\n";
+            code += "            return " + arm->body->to_webcc() + ";\n";
+        }
+    } else {
+        std::map<size_t, std::vector<std::pair<std::string, const MatchArm*>>> by_length;
+        for (const auto& c : cases) by_length[c.first.size()].push_back(c);
+        code += "        switch (_match_subject.length()) {\n";
+        for (const auto& [length, bucket] : by_length) {
+            code += "        case " + std::to_string(length) + ": {\n";
+            if (bucket.size() == 1) {
+                code += "            if (_match_subject == " + bucket[0].second->pattern.literal_value->to_webcc() + ") return " +
+                        bucket[0].second->body->to_webcc() + ";\n";
+            } else {
+                std::map<uint32_t, std::vector<const MatchArm*>> by_hash;
+                for (const auto& [key, arm] : bucket) by_hash[match_string_hash(key)].push_back(arm);
+                code += "            uint32_t _match_hash = 2166136261u;\n";
+                code += "            for (int _i = 0; _i < " + std::to_string(length) + "; _i++) _match_hash = (_match_hash ^ (uint8_t)_match_subject[_i]) * 16777619u;\n";
+                code += "            switch (_match_hash) {\n";
+                for (const auto& [hash, arms] : by_hash) {
+                    code += "            case " + std::to_string(hash) + "u:\n";
+                    for (const auto* arm : arms) {
+                        code += "                if (_match_subject == " + arm->pattern.literal_value->to_webcc() + ") return " +
+                                arm->body->to_webcc() + ";\n";
+                    }
+                    code += "                break;\n";
+                }
+                code += "            }\n";
+            }
+            code += "            break;\n";
+            code += "        }\n";
+        }
+    }
+    code += "        default:\n";
+    code += "            break;\n";
+    code += "        }\n";
+    if (else_arm) {
+        code += "        return " + else_arm->body->to_webcc() + ";\n";
+    }
+    code += "    }()";
+    return code;
+}
+
 // Match expression code generation
 // Generates a lambda (IIFE) with if-else chain
 std::string MatchExpr::to_webcc() {
+    std::string switch_code = generate_match_switch(*this);
+    if (!switch_code.empty()) return switch_code;
+
     std::string code = "[&]() {\n";
     code += "        const auto& _match_subject = " + subject->to_webcc() + ";\n";
     
@@ -1351,7 +1561,7 @@ bool MatchExpr::is_static() {
 std::string BlockExpr::to_webcc() {
     std::string code = "([&]() {\n";
     for (const auto& stmt : statements) {
-        code += "            " + stmt->to_webcc() + "\n";
+        code += "            " + statement_code(stmt.get()) + "\n";
     }
     code += "        }())";
     return code;
@@ -128,6 +128,19 @@ struct ReferenceExpression : Expression {
     std::vector<Expression*> get_children() override { return {operand.get()}; }
 };
 
+// Await expression: await FetchRequest.get(url) - suspends an async def until the operation completes.
+// Only valid as a top-level statement (or initializer/assignment value) of an async def body,
+// which lowers it to a resume point instead of calling to_webcc() directly.
+struct AwaitExpr : Expression {
+    std::unique_ptr<Expression> operand;
+
+    AwaitExpr(std::unique_ptr<Expression> expr) : operand(std::move(expr)) {}
+    std::string to_webcc() override;
+    // Start the awaited operation and register resume_callback (void(const coi::string&)) for its completion
+    std::string to_webcc_suspend(const std::string& resume_callback);
+    std::vector<Expression*> get_children() override { return {operand.get()}; }
+};
+
 // Move expression: :expr - explicitly transfers ownership
 struct MoveExpression : Expression {
     std::unique_ptr<Expression> operand;
@@ -209,7 +209,7 @@ std::string Assignment::to_webcc()
         result += "for (auto& " + var + " : " + name + ") {\n";
         result += info.item_creation_code;
         result += "}\n";
-        result += "if (--g_view_depth == 0) webcc::flush();";
+        result += "if (--g_view_depth == 0) g_dom_writes.flush();";
         return result;
     }
 
@@ -486,7 +486,7 @@ std::string ExpressionStatement::to_webcc()
                     std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
                     result = "if (!" + arr_name + ".empty()) {\n";
                     result += "    if (!" + info.elements_vec_name + ".empty()) {\n";
-                    result += "        webcc::dom::remove_element(" + info.elements_vec_name + ".back());\n";
+                    result += "        g_dom_writes.remove(" + info.elements_vec_name + ".back());\n";
                     result += "        " + info.elements_vec_name + ".pop_back();\n";
                     result += "    }\n";
                     result += "    " + arr_name + ".pop_back();\n";
@@ -497,7 +497,7 @@ std::string ExpressionStatement::to_webcc()
                 else if (method == "clear" && call->args.empty())
                 {
                     std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
-                    result = "for (auto& _el : " + info.elements_vec_name + ") { webcc::dom::remove_element(_el); }\n";
+                    result = "for (auto& _el : " + info.elements_vec_name + ") { g_dom_writes.remove(_el); }\n";
                     result += info.elements_vec_name + ".clear();\n";
                     result += arr_name + ".clear();\n";
                     result += count_var + " = 0;\n";
@@ -518,7 +518,7 @@ std::string BlockStatement::to_webcc()
 {
     std::string code = "{\n";
     for (auto &stmt : statements)
-        code += stmt->to_webcc();
+        code += statement_code(stmt.get());
     code += "}\n";
     return code;
 }
@@ -529,15 +529,25 @@ void BlockStatement::collect_dependencies(std::set<std::string> &deps)
         stmt->collect_dependencies(deps);
 }
 
+// Body of an if or loop: a single statement that invalidates computed members gets braces so its
+// dirty flags stay conditional
+static std::string branch_code(Statement *body)
+{
+    std::string invalidation = computed_invalidation(body);
+    if (invalidation.empty() || dynamic_cast<BlockStatement *>(body))
+        return body->to_webcc();
+    return "{ " + statement_code(body) + " }";
+}
+
 std::string IfStatement::to_webcc()
 {
     std::string cond = strip_outer_parens(condition->to_webcc());
     std::string code = "if(" + cond + ") ";
-    code += then_branch->to_webcc();
+    code += branch_code(then_branch.get());
     if (else_branch)
     {
         code += " else ";
-        code += else_branch->to_webcc();
+        code += branch_code(else_branch.get());
     }
     return code;
 }
@@ -555,7 +565,7 @@ std::string ForRangeStatement::to_webcc()
     std::string code = "for(int " + var_name + " = " + start->to_webcc() + "; ";
     code += "(" + var_name + " < " + end->to_webcc() + "); ";
     code += var_name + "++) ";
-    code += body->to_webcc();
+    code += branch_code(body.get());
     return code;
 }
 
@@ -569,7 +579,7 @@ void ForRangeStatement::collect_dependencies(std::set<std::string> &deps)
 std::string ForEachStatement::to_webcc()
 {
     std::string code = "for(auto& " + var_name + " : " + iterable->to_webcc() + ") ";
-    code += body->to_webcc();
+    code += branch_code(body.get());
     return code;
 }
 
@@ -717,3 +727,141 @@ void collect_mods_recursive(Statement *stmt, std::set<std::string> &mods)
         }
     }
 }
+
+static void collect_expr_calls(Expression *expr, std::set<std::string> &calls)
+{
+    if (!expr)
+        return;
+    if (auto call = dynamic_cast<FunctionCall *>(expr))
+    {
+        if (call->name.find('.') == std::string::npos && call->name.find("::") == std::string::npos)
+        {
+            calls.insert(call->name);
+        }
+    }
+    if (auto match = dynamic_cast<MatchExpr *>(expr))
+    {
+        collect_expr_calls(match->subject.get(), calls);
+        for (auto &arm : match->arms)
+        {
+            collect_expr_calls(arm.body.get(), calls);
+        }
+        return;
+    }
+    if (auto block = dynamic_cast<BlockExpr *>(expr))
+    {
+        for (auto &s : block->statements)
+        {
+            collect_calls_recursive(s.get(), calls);
+        }
+        return;
+    }
+    for (auto *child : expr->get_children())
+    {
+        collect_expr_calls(child, calls);
+    }
+}
+
+void collect_calls_recursive(Statement *stmt, std::set<std::string> &calls)
+{
+    if (auto decl = dynamic_cast<VarDeclaration *>(stmt))
+    {
+        collect_expr_calls(decl->initializer.get(), calls);
+    }
+    else if (auto assign = dynamic_cast<Assignment *>(stmt))
+    {
+        collect_expr_calls(assign->value.get(), calls);
+    }
+    else if (auto idxAssign = dynamic_cast<IndexAssignment *>(stmt))
+    {
+        collect_expr_calls(idxAssign->array.get(), calls);
+        collect_expr_calls(idxAssign->index.get(), calls);
+        collect_expr_calls(idxAssign->value.get(), calls);
+    }
+    else if (auto memberAssign = dynamic_cast<MemberAssignment *>(stmt))
+    {
+        collect_expr_calls(memberAssign->object.get(), calls);
+        collect_expr_calls(memberAssign->value.get(), calls);
+    }
+    else if (auto ret = dynamic_cast<ReturnStatement *>(stmt))
+    {
+        collect_expr_calls(ret->value.get(), calls);
+    }
+    else if (auto exprStmt = dynamic_cast<ExpressionStatement *>(stmt))
+    {
+        collect_expr_calls(exprStmt->expression.get(), calls);
+    }
+    else if (auto block = dynamic_cast<BlockStatement *>(stmt))
+    {
+        for (auto &s : block->statements)
+        {
+            collect_calls_recursive(s.get(), calls);
+        }
+    }
+    else if (auto ifStmt = dynamic_cast<IfStatement *>(stmt))
+    {
+        collect_expr_calls(ifStmt->condition.get(), calls);
+        collect_calls_recursive(ifStmt->then_branch.get(), calls);
+        if (ifStmt->else_branch)
+        {
+            collect_calls_recursive(ifStmt->else_branch.get(), calls);
+        }
+    }
+    else if (auto forRange = dynamic_cast<ForRangeStatement *>(stmt))
+    {
+        collect_expr_calls(forRange->start.get(), calls);
+        collect_expr_calls(forRange->end.get(), calls);
+        collect_calls_recursive(forRange->body.get(), calls);
+    }
+    else if (auto forEach = dynamic_cast<ForEachStatement *>(stmt))
+    {
+        collect_expr_calls(forEach->iterable.get(), calls);
+        collect_calls_recursive(forEach->body.get(), calls);
+    }
+}
+
+std::string computed_invalidation(Statement *stmt)
+{
+    if (g_computed_dependents.empty())
+        return "";
+    std::set<std::string> mods;
+    if (auto forEach = dynamic_cast<ForEachStatement *>(stmt))
+    {
+        // Changes through the loop item change the iterable once the loop is done
+        std::set<std::string> body_mods;
+        collect_mods_recursive(forEach->body.get(), body_mods);
+        auto id = dynamic_cast<Identifier *>(forEach->iterable.get());
+        if (id && body_mods.count(forEach->var_name))
+            mods.insert(id->name);
+    }
+    else if (!dynamic_cast<BlockStatement *>(stmt) && !dynamic_cast<IfStatement *>(stmt) &&
+             !dynamic_cast<ForRangeStatement *>(stmt))
+    {
+        collect_mods_recursive(stmt, mods);
+    }
+
+    std::set<std::string> dirty;
+    for (const auto &name : mods)
+    {
+        auto it = g_computed_dependents.find(name);
+        if (it != g_computed_dependents.end())
+            dirty.insert(it->second.begin(), it->second.end());
+    }
+    std::string code;
+    for (const auto &name : dirty)
+        code += " _computed_" + name + "_dirty = true;";
+    return code;
+}
+
+std::string statement_code(Statement *stmt)
+{
+    std::string code = stmt->to_webcc();
+    std::string invalidation = computed_invalidation(stmt);
+    if (invalidation.empty())
+        return code;
+    // Keep the statement's own line ending after the flags
+    bool newline = !code.empty() && code.back() == '\n';
+    if (newline)
+        code.pop_back();
+    return code + invalidation + (newline ? "\n" : "");
+}
@@ -11,6 +11,7 @@ struct VarDeclaration : Statement {
     bool is_reference = false;
     bool is_public = false;
     bool is_move = false;  // true if initialized with &expr (move semantics)
+    bool is_computed = false;  // computed member: initializer is re-evaluated lazily when its dependencies change
 
     std::string to_webcc() override;
 };
@@ -110,3 +111,13 @@ struct ForEachStatement : Statement {
 
 // Recursively collect modified variables in statements
 void collect_mods_recursive(Statement* stmt, std::set<std::string>& mods);
+
+// Dirty flags of the computed members a statement invalidates (" _computed_<name>_dirty = true;"
+// each), empty for compound statements, whose inner statements carry their own
+std::string computed_invalidation(Statement* stmt);
+
+// Statement code followed by computed_invalidation(), so a later read in the same method sees the change
+std::string statement_code(Statement* stmt);
+
+// Recursively collect the names of plain (non-member) function calls in statements
+void collect_calls_recursive(Statement* stmt, std::set<std::string>& calls);
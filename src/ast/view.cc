@@ -1,6 +1,8 @@
 #include "view.h"
 #include "formatter.h"
 #include "../codegen/codegen_utils.h"
+#include "../cli/error.h"
+#include "codegen_state.h"
 
 // Global set of components with scoped CSS (populated in main.cc before code generation)
 std::set<std::string> g_components_with_scoped_css;
@@ -222,6 +224,14 @@ void ComponentInstantiation::generate_code(ViewCodegenContext& ctx)
         instance_name = qname + "_" + std::to_string(id);
     }
 
+    // Children of a reactive if-branch are held by pointer and built when the branch activates
+    std::string member = instance_name + ".";
+    if (!ctx.in_loop && ctx.in_if_branch)
+    {
+        ctx.ss << "        if (!" << instance_name << ") " << instance_name << " = new " << qname << "();\n";
+        member = instance_name + "->";
+    }
+
     // Set props
     for (auto &prop : props)
     {
@@ -231,21 +241,21 @@ void ComponentInstantiation::generate_code(ViewCodegenContext& ctx)
             // Callback with params: generate lambda that forwards args
             std::string lambda_params = build_lambda_params_from_types(prop.callback_param_types);
             std::string forward_args = build_forward_args(prop.callback_param_types.size());
-            ctx.ss << "        " << instance_name << "." << prop.name << " = [this](" << lambda_params << ") { this->" << val << "(" << forward_args << "); };\n";
+            ctx.ss << "        " << member << prop.name << " = [this](" << lambda_params << ") { this->" << val << "(" << forward_args << "); };\n";
         }
         else if (ctx.method_names.count(val) || prop.is_callback)
         {
             // No-param callback or method reference
-            ctx.ss << "        " << instance_name << "." << prop.name << " = [this]() { this->" << val << "(); };\n";
+            ctx.ss << "        " << member << prop.name << " = [this]() { this->" << val << "(); };\n";
         }
         else if (prop.is_reference)
         {
             // Actual reference: pointer to variable
-            ctx.ss << "        " << instance_name << "." << prop.name << " = &(" << val << ");\n";
+            ctx.ss << "        " << member << prop.name << " = &(" << val << ");\n";
         }
         else
         {
-            ctx.ss << "        " << instance_name << "." << prop.name << " = " << val << ";\n";
+            ctx.ss << "        " << member << prop.name << " = " << val << ";\n";
         }
     }
 
@@ -281,7 +291,7 @@ void ComponentInstantiation::generate_code(ViewCodegenContext& ctx)
 
                 if (!update_calls.empty())
                 {
-                    ctx.ss << "        " << instance_name << "." << callback_name << " = [this]() { " << update_calls << "};\n";
+                    ctx.ss << "        " << member << callback_name << " = [this]() { " << update_calls << "};\n";
                 }
             }
         }
@@ -290,11 +300,11 @@ void ComponentInstantiation::generate_code(ViewCodegenContext& ctx)
     // Call view
     if (!ctx.parent.empty())
     {
-        ctx.ss << "        " << instance_name << ".view(" << ctx.parent << ");\n";
+        ctx.ss << "        " << member << "view(" << ctx.parent << ");\n";
     }
     else
     {
-        ctx.ss << "        " << instance_name << ".view();\n";
+        ctx.ss << "        " << member << "view();\n";
     }
 }
 
@@ -406,7 +416,7 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
         var = "_el_" + std::to_string(my_id);
         ctx.ss << "        webcc::handle " << var << " = webcc::handle(webcc::next_deferred_handle());\n";
         if (has_scoped_css) {
-            ctx.ss << "        webcc::dom::create_element_deferred_scoped(" << var << ", \"" << tag << "\", \"" << ctx.parent_component_name << "\");\n";
+            ctx.ss << "        webcc::dom::create_element_deferred_scoped(" << var << ", \"" << tag << "\", \"" << css_scope_name(ctx.parent_component_name) << "\");\n";
         } else {
             ctx.ss << "        webcc::dom::create_element_deferred(" << var << ", \"" << tag << "\");\n";
         }
@@ -417,7 +427,7 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
         var = "el[" + std::to_string(my_id) + "]";
         ctx.ss << "        " << var << " = webcc::DOMElement(webcc::next_deferred_handle());\n";
         if (has_scoped_css) {
-            ctx.ss << "        webcc::dom::create_element_deferred_scoped(" << var << ", \"" << tag << "\", \"" << ctx.parent_component_name << "\");\n";
+            ctx.ss << "        webcc::dom::create_element_deferred_scoped(" << var << ", \"" << tag << "\", \"" << css_scope_name(ctx.parent_component_name) << "\");\n";
         } else {
             ctx.ss << "        webcc::dom::create_element_deferred(" << var << ", \"" << tag << "\");\n";
         }
@@ -428,9 +438,46 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
         ctx.ss << "        " << ref_binding << " = " << var << ";\n";
     }
 
+    // Event modifiers (oninput:debounce={150}) rate-limit the element's handler for that event
+    std::map<std::string, std::pair<std::string, std::string>> rate_limits;
+    for (auto &attr : attributes)
+    {
+        size_t colon = attr.name.find(':');
+        if (colon == std::string::npos || !attr.name.starts_with("on"))
+            continue;
+        if (ctx.in_loop)
+        {
+            ErrorHandler::compiler_error("Event modifier '" + attr.name + "' is not supported inside view loops", line);
+        }
+        rate_limits[attr.name.substr(2, colon - 2)] = {attr.name.substr(colon + 1), attr.value->to_webcc()};
+    }
+    // Rows of a reactive loop list their handlers, so removing a row can drop them
+    auto track_row_handler = [&](const std::string &dispatcher)
+    {
+        if (!ctx.row_dispatchers)
+            return;
+        ctx.row_dispatchers->insert(dispatcher);
+        ctx.ss << "        _row_handlers.push_back(" << var << ");\n";
+    };
+    auto push_handler = [&](const std::string &event_type, Expression *value, bool is_call)
+    {
+        EventHandler handler{my_id, event_type, value->to_webcc(), is_call};
+        auto it = rate_limits.find(event_type);
+        if (it != rate_limits.end())
+        {
+            handler.rate_limit = it->second.first;
+            handler.rate_ms = it->second.second;
+        }
+        ctx.event_handlers.push_back(handler);
+    };
+
     // Attributes
     for (auto &attr : attributes)
     {
+        if (attr.name.starts_with("on") && attr.name.find(':') != std::string::npos)
+        {
+            continue; // Event modifier, applied to the matching handler above
+        }
         if (attr.name == "onclick")
         {
             ctx.ss << "        webcc::dom::add_click_listener(" << var << ");\n";
@@ -441,13 +488,14 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 std::string capture = build_lambda_capture(ctx.loop_var_name);
                 std::string handler_code = attr.value->to_webcc();
                 if (is_call)
-                    ctx.ss << "        g_dispatcher.set(" << var << ", " << capture << "() { " << handler_code << "; });\n";
+                    ctx.ss << "        g_dispatcher.set(" << var << ", " << capture << "() { " << handler_code << "; }, this);\n";
                 else
-                    ctx.ss << "        g_dispatcher.set(" << var << ", " << capture << "() { " << handler_code << "(); });\n";
+                    ctx.ss << "        g_dispatcher.set(" << var << ", " << capture << "() { " << handler_code << "(); }, this);\n";
+                track_row_handler("g_dispatcher");
             }
             else
             {
-                ctx.event_handlers.push_back({my_id, "click", attr.value->to_webcc(), is_call});
+                push_handler("click", attr.value.get(), is_call);
             }
         }
         else if (attr.name == "oninput")
@@ -459,13 +507,14 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 std::string capture = build_lambda_capture(ctx.loop_var_name);
                 std::string handler_code = attr.value->to_webcc();
                 if (is_call)
-                    ctx.ss << "        g_input_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "; });\n";
+                    ctx.ss << "        g_input_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "; }, this);\n";
                 else
-                    ctx.ss << "        g_input_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "(_value); });\n";
+                    ctx.ss << "        g_input_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "(_value); }, this);\n";
+                track_row_handler("g_input_dispatcher");
             }
             else
             {
-                ctx.event_handlers.push_back({my_id, "input", attr.value->to_webcc(), is_call});
+                push_handler("input", attr.value.get(), is_call);
             }
         }
         else if (attr.name == "onchange")
@@ -477,13 +526,14 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 std::string capture = build_lambda_capture(ctx.loop_var_name);
                 std::string handler_code = attr.value->to_webcc();
                 if (is_call)
-                    ctx.ss << "        g_change_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "; });\n";
+                    ctx.ss << "        g_change_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "; }, this);\n";
                 else
-                    ctx.ss << "        g_change_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "(_value); });\n";
+                    ctx.ss << "        g_change_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "(_value); }, this);\n";
+                track_row_handler("g_change_dispatcher");
             }
             else
             {
-                ctx.event_handlers.push_back({my_id, "change", attr.value->to_webcc(), is_call});
+                push_handler("change", attr.value.get(), is_call);
             }
         }
         else if (attr.name == "onkeydown")
@@ -495,13 +545,14 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 std::string capture = build_lambda_capture(ctx.loop_var_name);
                 std::string handler_code = attr.value->to_webcc();
                 if (is_call)
-                    ctx.ss << "        g_keydown_dispatcher.set(" << var << ", " << capture << "(int _keycode) { " << handler_code << "; });\n";
+                    ctx.ss << "        g_keydown_dispatcher.set(" << var << ", " << capture << "(int _keycode) { " << handler_code << "; }, this);\n";
                 else
-                    ctx.ss << "        g_keydown_dispatcher.set(" << var << ", " << capture << "(int _keycode) { " << handler_code << "(_keycode); });\n";
+                    ctx.ss << "        g_keydown_dispatcher.set(" << var << ", " << capture << "(int _keycode) { " << handler_code << "(_keycode); }, this);\n";
+                track_row_handler("g_keydown_dispatcher");
             }
             else
             {
-                ctx.event_handlers.push_back({my_id, "keydown", attr.value->to_webcc(), is_call});
+                push_handler("keydown", attr.value.get(), is_call);
             }
         }
         else
@@ -692,6 +743,60 @@ static void generate_prop_update_code(std::stringstream &ss, ComponentInstantiat
     }
 }
 
+// Handle of the DOM node a top-level child of a kept <if> branch creates, which is hidden and
+// shown in place of rebuilding the branch. Must be called before the child's code is generated.
+static std::string keep_branch_root(ASTNode *child, const ViewCodegenContext &ctx, int line)
+{
+    if (dynamic_cast<HTMLElement *>(child) || dynamic_cast<ViewRawElement *>(child))
+    {
+        return "el[" + std::to_string(ctx.counter) + "]";
+    }
+    if (auto comp = dynamic_cast<ComponentInstantiation *>(child))
+    {
+        if (comp->is_member_reference)
+        {
+            return comp->member_name + "._get_root_element()";
+        }
+        std::string qname = qualified_name(comp->module_prefix, comp->component_name);
+        auto it = ctx.component_counters.find(qname);
+        int id = it == ctx.component_counters.end() ? 0 : it->second;
+        return qname + "_" + std::to_string(id) + "->_get_root_element()";
+    }
+    ErrorHandler::compiler_error("<if keep> branches can only contain elements and components at their top level; wrap text, loops and nested ifs in an element", line);
+}
+
+// Record what a top-level child of a reactive <if> branch appends to the region's parent.
+// Must be called before the child's code is generated.
+static void note_branch_top(ASTNode *child, const ViewCodegenContext &ctx, BranchTop &top)
+{
+    if (dynamic_cast<HTMLElement *>(child) || dynamic_cast<ViewRawElement *>(child) ||
+        dynamic_cast<TextNode *>(child) || dynamic_cast<Expression *>(child))
+    {
+        top.elements.push_back(ctx.counter);
+    }
+    else if (auto comp = dynamic_cast<ComponentInstantiation *>(child))
+    {
+        if (comp->is_member_reference)
+        {
+            top.member_refs.insert(comp->member_name);
+            return;
+        }
+        std::string qname = qualified_name(comp->module_prefix, comp->component_name);
+        auto it = ctx.component_counters.find(qname);
+        int id = it == ctx.component_counters.end() ? 0 : it->second;
+        top.components.insert(qname + "_" + std::to_string(id));
+    }
+    else if (dynamic_cast<ViewIfStatement *>(child))
+    {
+        top.ifs.push_back(*ctx.if_counter);
+    }
+    else if ((dynamic_cast<ViewForRangeStatement *>(child) || dynamic_cast<ViewForEachStatement *>(child)) &&
+             ctx.loop_regions && ctx.loop_counter)
+    {
+        top.loops.push_back(*ctx.loop_counter);
+    }
+}
+
 // ViewIfStatement
 void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
 {
@@ -699,6 +804,10 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
     // Simple static if for nested loops
     if (ctx.in_loop || !ctx.if_regions || !ctx.if_counter)
     {
+        if (keep)
+        {
+            ErrorHandler::compiler_error("<if keep> is not supported inside loops", line);
+        }
         int loop_id_before = ctx.loop_counter ? *ctx.loop_counter : 0;
 
         ctx.ss << "        if (" << strip_outer_parens(condition->to_webcc()) << ") {\n";
@@ -727,12 +836,19 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
         return;
     }
 
+    // Kept branches are hidden by hiding their top-level nodes, so the region needs a parent element
+    if (keep && ctx.parent == "parent")
+    {
+        ErrorHandler::compiler_error("<if keep> cannot be the root of a view; wrap it in an element", line);
+    }
+
     // Reactive if/else
     int my_if_id = (*ctx.if_counter)++;
     if_id = my_if_id;
 
     IfRegion region;
     region.if_id = my_if_id;
+    region.keep = keep;
     region.condition_code = condition->to_webcc();
     condition->collect_dependencies(region.dependencies);
     condition->collect_member_dependencies(region.member_dependencies);
@@ -748,9 +864,12 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
     std::vector<Binding> then_bindings;
     ViewCodegenContext then_ctx{then_ss, if_parent, ctx.counter, ctx.event_handlers, then_bindings,
         ctx.component_counters, ctx.method_names, ctx.parent_component_name, false,
-        ctx.loop_regions, ctx.loop_counter, ctx.if_regions, ctx.if_counter, ctx.loop_var_name};
+        ctx.loop_regions, ctx.loop_counter, ctx.if_regions, ctx.if_counter, ctx.loop_var_name, true};
     for (auto &child : then_children)
     {
+        if (keep)
+            region.then_roots.push_back(keep_branch_root(child.get(), then_ctx, line));
+        note_branch_top(child.get(), then_ctx, region.then_top);
         generate_view_child(child.get(), then_ctx);
     }
     int counter_after_then = ctx.counter;
@@ -794,11 +913,14 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
     std::vector<Binding> else_bindings;
     ViewCodegenContext else_ctx{else_ss, if_parent, ctx.counter, ctx.event_handlers, else_bindings,
         ctx.component_counters, ctx.method_names, ctx.parent_component_name, false,
-        ctx.loop_regions, ctx.loop_counter, ctx.if_regions, ctx.if_counter, ctx.loop_var_name};
+        ctx.loop_regions, ctx.loop_counter, ctx.if_regions, ctx.if_counter, ctx.loop_var_name, true};
     if (!else_children.empty())
     {
         for (auto &child : else_children)
         {
+            if (keep)
+                region.else_roots.push_back(keep_branch_root(child.get(), else_ctx, line));
+            note_branch_top(child.get(), else_ctx, region.else_top);
             generate_view_child(child.get(), else_ctx);
         }
     }
@@ -857,10 +979,14 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
     ctx.ss << "        webcc::dom::create_comment_deferred(_if_" << my_if_id << "_anchor, \"coi-⚓\");\n";
     ctx.ss << "        if (" << strip_outer_parens(region.condition_code) << ") {\n";
     ctx.ss << "        _if_" << my_if_id << "_state = true;\n";
+    if (keep)
+        ctx.ss << "        _if_" << my_if_id << "_then_built = true; _if_" << my_if_id << "_else_built = false;\n";
     // Use original append_child for initial render (before anchor is in DOM)
     ctx.ss << then_ss.str();
     ctx.ss << "        } else {\n";
     ctx.ss << "        _if_" << my_if_id << "_state = false;\n";
+    if (keep)
+        ctx.ss << "        _if_" << my_if_id << "_else_built = true; _if_" << my_if_id << "_then_built = false;\n";
     ctx.ss << else_ss.str();
     ctx.ss << "        }\n";
     // Append anchor after the conditional content
@@ -899,7 +1025,7 @@ void ViewRawElement::generate_code(ViewCodegenContext& ctx)
         var = "_el_" + std::to_string(my_id);
         ctx.ss << "        webcc::handle " << var << " = webcc::handle(webcc::next_deferred_handle());\n";
         if (has_scoped_css) {
-            ctx.ss << "        webcc::dom::create_element_deferred_scoped(" << var << ", \"span\", \"" << ctx.parent_component_name << "\");\n";
+            ctx.ss << "        webcc::dom::create_element_deferred_scoped(" << var << ", \"span\", \"" << css_scope_name(ctx.parent_component_name) << "\");\n";
         } else {
             ctx.ss << "        webcc::dom::create_element_deferred(" << var << ", \"span\");\n";
         }
@@ -909,7 +1035,7 @@ void ViewRawElement::generate_code(ViewCodegenContext& ctx)
         var = "el[" + std::to_string(my_id) + "]";
         ctx.ss << "        " << var << " = webcc::DOMElement(webcc::next_deferred_handle());\n";
         if (has_scoped_css) {
-            ctx.ss << "        webcc::dom::create_element_deferred_scoped(" << var << ", \"span\", \"" << ctx.parent_component_name << "\");\n";
+            ctx.ss << "        webcc::dom::create_element_deferred_scoped(" << var << ", \"span\", \"" << css_scope_name(ctx.parent_component_name) << "\");\n";
         } else {
             ctx.ss << "        webcc::dom::create_element_deferred(" << var << ", \"span\");\n";
         }
@@ -1070,7 +1196,8 @@ void ViewForRangeStatement::generate_code(ViewCodegenContext& ctx)
 
     ViewCodegenContext item_ctx{item_ss, loop_parent_var, temp_counter, ctx.event_handlers, ctx.bindings,
         temp_comp_counters, ctx.method_names, ctx.parent_component_name, true,
-        nullptr, nullptr, nullptr, nullptr, var_name};
+        nullptr, nullptr, nullptr, nullptr, var_name, false,
+        region.is_html_loop ? &region.row_dispatchers : nullptr};
     for (auto &child : children)
     {
         generate_view_child(child.get(), item_ctx);
@@ -1171,7 +1298,8 @@ void ViewForEachStatement::generate_code(ViewCodegenContext& ctx)
 
     ViewCodegenContext item_ctx{item_ss, loop_parent_var, temp_counter, ctx.event_handlers, ctx.bindings,
         temp_comp_counters, ctx.method_names, ctx.parent_component_name, true,
-        nullptr, nullptr, nullptr, nullptr, var_name};
+        nullptr, nullptr, nullptr, nullptr, var_name, false,
+        region.is_html_loop ? &region.row_dispatchers : nullptr};
     for (auto &child : children)
     {
         generate_view_child(child.get(), item_ctx);
@@ -20,6 +20,8 @@ struct EventHandler {
     std::string event_type;      // "click", "input", "change", "keydown"
     std::string handler_code;
     bool is_function_call;
+    std::string rate_limit = {}; // "", "debounce" or "throttle" (from on<event>:<modifier>={ms})
+    std::string rate_ms = {};    // Interval expression in milliseconds
 };
 
 struct Binding {
@@ -63,6 +65,17 @@ struct LoopRegion {
     std::string key_expr;
     std::string key_type;
     std::string iterable_expr;
+    std::set<std::string> row_dispatchers;  // Element dispatchers the rows of an HTML loop register into
+};
+
+// Nodes one branch of an if region appends directly to the region's parent. Tearing the branch
+// down only has to remove these from the DOM; everything else is nested inside them.
+struct BranchTop {
+    std::vector<int> elements;           // Element and text node ids
+    std::vector<int> ifs;                // Nested if regions (their anchor and live branch)
+    std::vector<int> loops;              // Loop regions (their anchor and items)
+    std::set<std::string> components;    // Child component members (e.g. "Card_0")
+    std::set<std::string> member_refs;
 };
 
 // Struct to track reactive if/else regions
@@ -85,6 +98,11 @@ struct IfRegion {
     std::vector<int> else_if_ids;
     std::vector<std::string> then_member_refs;  // Member component references in then branch
     std::vector<std::string> else_member_refs;  // Member component references in else branch
+    bool keep = false;                          // <if cond keep>: branches are hidden instead of destroyed
+    std::vector<std::string> then_roots;        // Top-level DOM handles of each branch (keep regions)
+    std::vector<std::string> else_roots;
+    BranchTop then_top;
+    BranchTop else_top;
 };
 
 // Context for view code generation - bundles common parameters
@@ -103,19 +121,22 @@ struct ViewCodegenContext {
     std::vector<IfRegion>* if_regions = nullptr;
     int* if_counter = nullptr;
     std::string loop_var_name;
+    bool in_if_branch = false;  // Inside a reactive <if> branch: child components are created lazily
+    // Inside the rows of a reactive HTML loop: handlers are also appended to the row's _row_handlers
+    std::set<std::string>* row_dispatchers = nullptr;
 
     // Create a child context with a new parent element
     ViewCodegenContext with_parent(const std::string& new_parent) const {
         return ViewCodegenContext{ss, new_parent, counter, event_handlers, bindings,
             component_counters, method_names, parent_component_name, in_loop,
-            loop_regions, loop_counter, if_regions, if_counter, loop_var_name};
+            loop_regions, loop_counter, if_regions, if_counter, loop_var_name, in_if_branch, row_dispatchers};
     }
 
     // Create a context for loop iteration (in_loop = true, clear region pointers)
     ViewCodegenContext for_loop(const std::string& new_parent, const std::string& var_name) const {
         return ViewCodegenContext{ss, new_parent, counter, event_handlers, bindings,
             component_counters, method_names, parent_component_name, true,
-            nullptr, nullptr, nullptr, nullptr, var_name};
+            nullptr, nullptr, nullptr, nullptr, var_name, false, row_dispatchers};
     }
 };
 
@@ -147,6 +168,7 @@ struct ViewIfStatement : ASTNode {
     std::unique_ptr<Expression> condition;
     std::vector<std::unique_ptr<ASTNode>> then_children;
     std::vector<std::unique_ptr<ASTNode>> else_children;
+    bool keep = false;  // Build each branch once and toggle visibility
     int if_id = -1;
 
     void generate_code(ViewCodegenContext& ctx);
@@ -1,6 +1,7 @@
 #include "cli.h"
 #include "error.h"
 #include "version.h"
+#include "release.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -500,7 +501,8 @@ static fs::path find_entry_point()
     return fs::path();
 }
 
-int build_project(bool keep_cc, bool cc_only, bool silent_banner)
+int build_project(bool keep_cc, bool cc_only, bool silent_banner, bool release, bool debug,
+                  bool record, const std::string &replay)
 {
     if (!silent_banner)
     {
@@ -518,8 +520,9 @@ int build_project(bool keep_cc, bool cc_only, bool silent_banner)
     fs::path project_dir = fs::current_path();
     fs::path dist_dir = project_dir / "dist";
 
-    // Create dist directory
+    // Create dist directory (dropping outputs of a previous release build)
     fs::create_directories(dist_dir);
+    remove_release_artifacts(dist_dir);
 
     // Copy assets folder if it exists
     fs::path assets_dir = project_dir / "assets";
@@ -553,6 +556,14 @@ int build_project(bool keep_cc, bool cc_only, bool silent_banner)
         extra_flags += " --keep-cc";
     if (cc_only)
         extra_flags += " --cc-only";
+    if (release)
+        extra_flags += " --release";
+    if (debug)
+        extra_flags += " --debug";
+    if (record)
+        extra_flags += " --record";
+    if (!replay.empty())
+        extra_flags += " --replay \"" + replay + "\"";
     std::string cmd = "bash -c 'set -o pipefail; " + coi_bin.string() + " " + entry.string() + " --out " + dist_dir.string() + extra_flags + " 2>&1 | grep -v \"Success! Run\"'";
 
     std::cout << BRAND << "▶" << RESET << " Building..." << std::endl;
@@ -564,16 +575,26 @@ int build_project(bool keep_cc, bool cc_only, bool silent_banner)
         return 1;
     }
 
+    if (release && !cc_only)
+    {
+        std::cout << BRAND << "▶" << RESET << " Writing release artifacts..." << std::endl;
+        if (!write_release_artifacts(dist_dir))
+        {
+            ErrorHandler::build_failed();
+            return 1;
+        }
+    }
+
     std::cout << GREEN << "✓" << RESET << " Built to " << BOLD << "dist/" << RESET << std::endl;
     return 0;
 }
 
-int dev_project(bool keep_cc, bool cc_only, bool hot_reloading)
+int dev_project(bool keep_cc, bool cc_only, bool hot_reloading, bool debug)
 {
     print_banner("dev");
 
     // First build (silent banner since dev already showed one)
-    int ret = build_project(keep_cc, cc_only, true);
+    int ret = build_project(keep_cc, cc_only, true, false, debug);
     if (ret != 0)
     {
         return ret;
@@ -608,6 +629,7 @@ int dev_project(bool keep_cc, bool cc_only, bool hot_reloading)
     if (!hot_reloading) cmd += " --no-watch";
     if (keep_cc) cmd += " --keep-cc";
     if (cc_only) cmd += " --cc-only";
+    if (debug) cmd += " --debug";
 
     return system(cmd.c_str());
 }
@@ -658,7 +680,7 @@ void print_help(const char *program_name)
     std::cout << std::endl;
     std::cout << "  " << BOLD << "Usage:" << RESET << std::endl;
     std::cout << "    " << CYAN << program_name << " init" << RESET << " [name] [--pkg]      Create a new project" << std::endl;
-    std::cout << "    " << CYAN << program_name << " build" << RESET << "                    Build the project" << std::endl;
+    std::cout << "    " << CYAN << program_name << " build" << RESET << " [--release]        Build the project" << std::endl;
     std::cout << "    " << CYAN << program_name << " dev" << RESET << " [--no-watch]         Build and start dev server" << std::endl;
     std::cout << "    " << CYAN << program_name << " add" << RESET << " <package>            Add a package from registry (scope/name)" << std::endl;
     std::cout << "    " << CYAN << program_name << " install" << RESET << "                  Install packages from coi.lock" << std::endl;
@@ -674,7 +696,12 @@ void print_help(const char *program_name)
     std::cout << "    " << DIM << "--cc-only" << RESET << "         Generate C++ only, skip WASM" << std::endl;
     std::cout << "    " << DIM << "--keep-cc" << RESET << "         Keep generated C++ files" << std::endl;
     std::cout << "    " << DIM << "--no-watch" << RESET << "        Disable hot reloading (dev only)" << std::endl;
+    std::cout << "    " << DIM << "--release" << RESET << "         Fingerprint and precompress dist/ (build only)" << std::endl;
+    std::cout << "    " << DIM << "--debug" << RESET << "           Add memory telemetry to the generated code" << std::endl;
+    std::cout << "    " << DIM << "--record" << RESET << "          Record events to a replayable trace" << std::endl;
+    std::cout << "    " << DIM << "--replay <file>" << RESET << "   Replay a recorded trace and time each frame" << std::endl;
     std::cout << "    " << DIM << "--pkg" << RESET << "             Create a package (init only)" << std::endl;
+    std::cout << "    " << DIM << "--offline" << RESET << "         Resolve from the registry cache (add/upgrade)" << std::endl;
     std::cout << std::endl;
     std::cout << "  " << BOLD << "Examples:" << RESET << std::endl;
     std::cout << "    " << DIM << "$" << RESET << " coi init my-app" << std::endl;
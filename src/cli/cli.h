@@ -32,12 +32,17 @@ enum class TemplateType {
 int init_project(const std::string& project_name_arg, TemplateType template_type = TemplateType::App);
 
 // Build a Coi project in the current directory
+// With release, dist/ additionally gets fingerprinted, precompressed artifacts and a manifest
+// With debug, the generated code carries memory telemetry (see the Memory type)
+// With record, the app logs its events to a trace; a non-empty replay (trace file path) builds
+// an app that replays that trace and reports per-frame cost
 // Returns 0 on success, non-zero on error
-int build_project(bool keep_cc = false, bool cc_only = false, bool silent_banner = false);
+int build_project(bool keep_cc = false, bool cc_only = false, bool silent_banner = false, bool release = false, bool debug = false,
+                  bool record = false, const std::string& replay = "");
 
 // Build and start dev server
 // Returns 0 on success, non-zero on error  
-int dev_project(bool keep_cc = false, bool cc_only = false, bool hot_reloading = false);
+int dev_project(bool keep_cc = false, bool cc_only = false, bool hot_reloading = false, bool debug = false);
 
 // Upgrade the local Coi compiler checkout by pulling latest changes and rebuilding
 // Returns 0 on success, non-zero on error
@@ -0,0 +1,192 @@
+#include "json_reader.h"
+#include <cstdint>
+
+void JsonReader::skip_whitespace() {
+    while (pos_ < text_.size() &&
+           (text_[pos_] == ' ' || text_[pos_] == '\n' || text_[pos_] == '\r' || text_[pos_] == '\t')) {
+        pos_++;
+    }
+}
+
+bool JsonReader::consume(char c) {
+    skip_whitespace();
+    if (pos_ < text_.size() && text_[pos_] == c) {
+        pos_++;
+        return true;
+    }
+    return false;
+}
+
+bool JsonReader::fail() {
+    failed_ = true;
+    return false;
+}
+
+bool JsonReader::begin_object() {
+    if (failed_ || !consume('{')) return fail();
+    first_member_ = true;
+    return true;
+}
+
+bool JsonReader::next_key(std::string& key) {
+    if (failed_) return false;
+    if (consume('}')) {
+        first_member_ = false;
+        return false;
+    }
+    if (!first_member_ && !consume(',')) return fail();
+    first_member_ = false;
+    if (!read_string(key) || !consume(':')) return fail();
+    return true;
+}
+
+bool JsonReader::end() {
+    if (failed_) return false;
+    skip_whitespace();
+    return pos_ == text_.size() || fail();
+}
+
+bool JsonReader::begin_array() {
+    if (failed_ || !consume('[')) return fail();
+    first_member_ = true;
+    return true;
+}
+
+bool JsonReader::next_element() {
+    if (failed_) return false;
+    if (consume(']')) {
+        first_member_ = false;
+        return false;
+    }
+    if (!first_member_ && !consume(',')) return fail();
+    first_member_ = false;
+    return true;
+}
+
+static void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += char(cp);
+    } else if (cp < 0x800) {
+        out += char(0xC0 | (cp >> 6));
+        out += char(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += char(0xE0 | (cp >> 12));
+        out += char(0x80 | ((cp >> 6) & 0x3F));
+        out += char(0x80 | (cp & 0x3F));
+    } else {
+        out += char(0xF0 | (cp >> 18));
+        out += char(0x80 | ((cp >> 12) & 0x3F));
+        out += char(0x80 | ((cp >> 6) & 0x3F));
+        out += char(0x80 | (cp & 0x3F));
+    }
+}
+
+bool JsonReader::read_string(std::string& out) {
+    if (failed_ || !consume('"')) return fail();
+    out.clear();
+
+    auto read_hex4 = [&](uint32_t& value) {
+        if (pos_ + 4 > text_.size()) return false;
+        value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char h = text_[pos_++];
+            value <<= 4;
+            if (h >= '0' && h <= '9') value |= uint32_t(h - '0');
+            else if (h >= 'a' && h <= 'f') value |= uint32_t(h - 'a' + 10);
+            else if (h >= 'A' && h <= 'F') value |= uint32_t(h - 'A' + 10);
+            else return false;
+        }
+        return true;
+    };
+
+    while (pos_ < text_.size()) {
+        char c = text_[pos_++];
+        if (c == '"') return true;
+        if (c != '\\') {
+            out += c;
+            continue;
+        }
+        if (pos_ >= text_.size()) break;
+        char esc = text_[pos_++];
+        switch (esc) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t cp;
+                if (!read_hex4(cp)) return fail();
+                // Surrogate pair
+                if (cp >= 0xD800 && cp <= 0xDBFF && text_.substr(pos_, 2) == "\\u") {
+                    pos_ += 2;
+                    uint32_t low;
+                    if (!read_hex4(low) || low < 0xDC00 || low > 0xDFFF) return fail();
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                }
+                append_utf8(out, cp);
+                break;
+            }
+            default:
+                return fail();
+        }
+    }
+    return fail();
+}
+
+bool JsonReader::read_int(int& out) {
+    if (failed_) return false;
+    skip_whitespace();
+    size_t start = pos_;
+    bool negative = pos_ < text_.size() && text_[pos_] == '-';
+    if (negative) pos_++;
+    long long value = 0;
+    size_t digits_start = pos_;
+    while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+        value = value * 10 + (text_[pos_++] - '0');
+        if (value > 0x7fffffff) return fail();
+    }
+    if (pos_ == digits_start) {
+        pos_ = start;
+        return fail();
+    }
+    out = int(negative ? -value : value);
+    return true;
+}
+
+bool JsonReader::skip_value() {
+    if (failed_) return false;
+    skip_whitespace();
+    if (pos_ >= text_.size()) return fail();
+
+    char c = text_[pos_];
+    if (c == '"') {
+        std::string ignored;
+        return read_string(ignored);
+    }
+    if (c == '{') {
+        begin_object();
+        std::string key;
+        while (next_key(key)) {
+            if (!skip_value()) return false;
+        }
+        return !failed_;
+    }
+    if (c == '[') {
+        begin_array();
+        while (next_element()) {
+            if (!skip_value()) return false;
+        }
+        return !failed_;
+    }
+    // Number or literal (true/false/null): consume the bare token
+    size_t start = pos_;
+    while (pos_ < text_.size() && text_[pos_] != ',' && text_[pos_] != '}' && text_[pos_] != ']' &&
+           text_[pos_] != ' ' && text_[pos_] != '\n' && text_[pos_] != '\r' && text_[pos_] != '\t') {
+        pos_++;
+    }
+    return pos_ > start ? true : fail();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Pull-style JSON reader: walks a document in order without building a tree.
+// Every call returns false on malformed input (and keeps failing afterwards), so callers
+// can chain reads and check the result once.
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) : text_(text) {}
+
+    // Objects: begin_object(), then next_key() until it returns false (closing '}' consumed)
+    bool begin_object();
+    bool next_key(std::string& key);
+
+    // Arrays: begin_array(), then next_element() until it returns false (closing ']' consumed)
+    bool begin_array();
+    bool next_element();
+
+    bool read_string(std::string& out);
+    bool read_int(int& out);
+    bool skip_value();
+
+    // After the top-level value: only whitespace may follow
+    bool end();
+
+    bool failed() const { return failed_; }
+
+private:
+    void skip_whitespace();
+    bool consume(char c);
+    bool fail();
+
+    std::string_view text_;
+    size_t pos_ = 0;
+    bool failed_ = false;
+    bool first_member_ = false;  // No ',' expected before the next key/element
+};
@@ -1,19 +1,31 @@
 #include "package_manager.h"
 #include "cli.h"
 #include "version.h"
+#include "sha256.h"
+#include "json_reader.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <cstdlib>
+#include <cctype>
+#include <unistd.h>
 #include <regex>
 #include <array>
 #include <vector>
+#include <mutex>
+#include <thread>
+#include <algorithm>
 
 using namespace colors;
 
 // Registry URL for fetching package info
 static const std::string REGISTRY_BASE_URL = "https://raw.githubusercontent.com/coi-lang/registry/main/packages/";
 
+// Worker count for concurrent clones and file hashing (both mostly wait on I/O)
+static unsigned install_workers() {
+    return std::clamp(std::thread::hardware_concurrency(), 2u, 8u);
+}
+
 static bool normalize_package_name(const std::string& raw_input, std::string& normalized, std::string& error) {
     if (raw_input.empty()) {
         error = "Package name is required";
@@ -59,25 +71,6 @@ static bool normalize_package_name(const std::string& raw_input, std::string& no
     return true;
 }
 
-// Simple JSON value extraction (avoids external dependency)
-static std::string extract_json_string(const std::string& json, const std::string& key) {
-    std::string search = "\"" + key + "\"";
-    size_t pos = json.find(search);
-    if (pos == std::string::npos) return "";
-    
-    pos = json.find(':', pos);
-    if (pos == std::string::npos) return "";
-    
-    pos = json.find('"', pos);
-    if (pos == std::string::npos) return "";
-    
-    size_t start = pos + 1;
-    size_t end = json.find('"', start);
-    if (end == std::string::npos) return "";
-    
-    return json.substr(start, end - start);
-}
-
 struct RegistryRelease {
     std::string version;
     int pond = 0;
@@ -86,107 +79,70 @@ struct RegistryRelease {
     std::string sha256;
 };
 
-static bool extract_string_field(const std::string& json, const std::string& key, std::string& out) {
-    std::regex re("\"" + key + "\"\\s*:\\s*\"([^\"]+)\"");
-    std::smatch m;
-    if (std::regex_search(json, m, re) && m.size() > 1) {
-        out = m[1].str();
-        return true;
-    }
-    return false;
-}
-
-static bool extract_int_field(const std::string& json, const std::string& key, int& out) {
-    std::regex re("\"" + key + "\"\\s*:\\s*([0-9]+)");
-    std::smatch m;
-    if (std::regex_search(json, m, re) && m.size() > 1) {
-        out = std::stoi(m[1].str());
-        return true;
-    }
-    return false;
-}
-
-static std::vector<std::string> extract_release_objects(const std::string& json) {
-    std::vector<std::string> releases;
-
-    size_t releases_pos = json.find("\"releases\"");
-    if (releases_pos == std::string::npos) return releases;
-
-    size_t array_start = json.find('[', releases_pos);
-    if (array_start == std::string::npos) return releases;
-
-    bool in_string = false;
-    bool escape = false;
-    int brace_depth = 0;
-    size_t object_start = std::string::npos;
-
-    for (size_t i = array_start + 1; i < json.size(); ++i) {
-        char c = json[i];
-
-        if (escape) {
-            escape = false;
-            continue;
-        }
-
-        if (c == '\\') {
-            escape = true;
-            continue;
-        }
-
-        if (c == '"') {
-            in_string = !in_string;
-            continue;
-        }
-
-        if (in_string) continue;
+struct RegistryDocument {
+    std::string name;
+    std::string repository;
+    std::vector<RegistryRelease> releases;  // Complete releases only, in registry order
+};
 
-        if (c == '{') {
-            if (brace_depth == 0) {
-                object_start = i;
+// Read one release object; returns false (with the reader still valid) if a required field is missing
+static bool parse_release(JsonReader& reader, RegistryRelease& release) {
+    bool has_pond = false;
+    bool has_min_drop = false;
+    std::string key;
+
+    if (!reader.begin_object()) return false;
+    while (reader.next_key(key)) {
+        if (key == "version") {
+            reader.read_string(release.version);
+        } else if (key == "compiler") {
+            reader.begin_object();
+            std::string field;
+            while (reader.next_key(field)) {
+                if (field == "pond") has_pond = reader.read_int(release.pond);
+                else if (field == "min-drop") has_min_drop = reader.read_int(release.min_drop);
+                else reader.skip_value();
             }
-            brace_depth++;
-            continue;
-        }
-
-        if (c == '}') {
-            if (brace_depth > 0) {
-                brace_depth--;
-                if (brace_depth == 0 && object_start != std::string::npos) {
-                    releases.push_back(json.substr(object_start, i - object_start + 1));
-                    object_start = std::string::npos;
-                }
+        } else if (key == "source") {
+            reader.begin_object();
+            std::string field;
+            while (reader.next_key(field)) {
+                if (field == "commit") reader.read_string(release.commit);
+                else if (field == "sha256") reader.read_string(release.sha256);
+                else reader.skip_value();
             }
-            continue;
-        }
-
-        if (c == ']' && brace_depth == 0) {
-            break;
+        } else {
+            reader.skip_value();
         }
     }
 
-    return releases;
+    return !reader.failed() && !release.version.empty() && has_pond && has_min_drop &&
+           !release.commit.empty() && !release.sha256.empty();
 }
 
-static bool parse_release(const std::string& release_json, RegistryRelease& release) {
-    if (!extract_string_field(release_json, "version", release.version)) return false;
-
-    std::smatch compiler_match;
-    std::regex compiler_re("\"compiler\"\\s*:\\s*\\{[^\\}]*\"pond\"\\s*:\\s*([0-9]+)[^\\}]*\"min-drop\"\\s*:\\s*([0-9]+)");
-    if (!std::regex_search(release_json, compiler_match, compiler_re) || compiler_match.size() < 3) {
-        return false;
-    }
-    release.pond = std::stoi(compiler_match[1].str());
-    release.min_drop = std::stoi(compiler_match[2].str());
-
-    std::smatch source_match;
-    std::regex source_re("\"source\"\\s*:\\s*\\{[^\\}]*\"commit\"\\s*:\\s*\"([^\"]+)\"[^\\}]*\"sha256\"\\s*:\\s*\"([^\"]+)\"");
-    if (!std::regex_search(release_json, source_match, source_re) || source_match.size() < 3) {
-        return false;
+static bool parse_registry_document(const std::string& json, RegistryDocument& doc) {
+    JsonReader reader(json);
+    std::string key;
+
+    if (!reader.begin_object()) return false;
+    while (reader.next_key(key)) {
+        if (key == "name") {
+            reader.read_string(doc.name);
+        } else if (key == "repository") {
+            reader.read_string(doc.repository);
+        } else if (key == "releases") {
+            reader.begin_array();
+            while (reader.next_element()) {
+                RegistryRelease release;
+                if (parse_release(reader, release)) {
+                    doc.releases.push_back(std::move(release));
+                }
+            }
+        } else {
+            reader.skip_value();
+        }
     }
-    release.commit = source_match[1].str();
-    release.sha256 = source_match[2].str();
-
-    return true;
+    return reader.end();
 }
 
 static int get_current_compiler_drop() {
@@ -373,29 +329,263 @@ bool write_lock_file(const fs::path& lock_path, const std::map<std::string, Lock
     return true;
 }
 
-bool fetch_package_info(const std::string& package_name, PackageInfo& package_info, const std::string& requested_version) {
-    std::string url = REGISTRY_BASE_URL + package_name + ".json";
-    
-    // Use curl to fetch
-    std::string cmd = "curl -s -f \"" + url + "\" 2>/dev/null";
-    std::string json = exec_command(cmd);
-    
-    if (json.empty()) {
-        // Try with sharded path (first two chars)
-        if (package_name.length() >= 2) {
-            std::string shard = package_name.substr(0, 2);
-            url = REGISTRY_BASE_URL + shard + "/" + package_name + ".json";
-            cmd = "curl -s -f \"" + url + "\" 2>/dev/null";
-            json = exec_command(cmd);
+static bool g_registry_offline = false;
+static std::mutex g_registry_mutex;  // Guards g_registry_documents and console output during prefetch
+static std::map<std::string, std::string> g_registry_documents;  // Package name -> index document, per process
+
+void set_registry_offline(bool offline) {
+    g_registry_offline = offline;
+}
+
+// Registry base URL ($COI_REGISTRY overrides, e.g. file:///path/to/packages/)
+static std::string registry_base_url() {
+    const char* env = std::getenv("COI_REGISTRY");
+    if (!env || !*env) return REGISTRY_BASE_URL;
+    std::string url = env;
+    if (url.back() != '/') url += '/';
+    return url;
+}
+
+// Local cache for registry index documents ($COI_CACHE, or ~/.coi/registry)
+static fs::path registry_cache_dir() {
+    if (const char* env = std::getenv("COI_CACHE"); env && *env) {
+        return fs::path(env);
+    }
+    const char* home = std::getenv("HOME");
+    if (!home || !*home) return {};
+    return fs::path(home) / ".coi" / "registry";
+}
+
+static std::string read_text_file(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return "";
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+static bool write_text_file_atomic(const fs::path& path, const std::string& content) {
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+    fs::path tmp = path;
+    tmp += ".tmp-" + std::to_string(getpid()) + "-" +
+           std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(tmp, std::ios::binary);
+        if (!file) return false;
+        file << content;
+        if (!file) return false;
+    }
+    fs::rename(tmp, path, ec);
+    if (ec) fs::remove(tmp, ec);
+    return !ec;
+}
+
+// Cache metadata: the URL the document came from plus its HTTP validators
+struct RegistryCacheMeta {
+    std::string url;
+    std::string etag;
+    std::string last_modified;
+};
+
+static RegistryCacheMeta read_cache_meta(const fs::path& path) {
+    RegistryCacheMeta meta;
+    std::istringstream in(read_text_file(path));
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t sep = line.find(' ');
+        if (sep == std::string::npos) continue;
+        std::string field = line.substr(0, sep);
+        std::string value = line.substr(sep + 1);
+        if (field == "url") meta.url = value;
+        else if (field == "etag") meta.etag = value;
+        else if (field == "last-modified") meta.last_modified = value;
+    }
+    return meta;
+}
+
+static std::string format_cache_meta(const RegistryCacheMeta& meta) {
+    std::string out = "url " + meta.url + "\n";
+    if (!meta.etag.empty()) out += "etag " + meta.etag + "\n";
+    if (!meta.last_modified.empty()) out += "last-modified " + meta.last_modified + "\n";
+    return out;
+}
+
+// Pull ETag / Last-Modified out of a curl -D header dump (last response wins after redirects)
+static void parse_validators(const std::string& headers, RegistryCacheMeta& meta) {
+    std::istringstream in(headers);
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) continue;
+        std::string field = line.substr(0, colon);
+        std::transform(field.begin(), field.end(), field.begin(), [](unsigned char c) { return std::tolower(c); });
+        size_t value_start = line.find_first_not_of(' ', colon + 1);
+        std::string value = value_start == std::string::npos ? "" : line.substr(value_start);
+        if (field == "etag") meta.etag = value;
+        else if (field == "last-modified") meta.last_modified = value;
+    }
+}
+
+enum class RegistryFetch { Fresh, NotModified, Failed };
+
+// Conditional GET of one URL. On Fresh, body and validators are filled in.
+// Double-quoted value for a curl config file. Line breaks are dropped so a value cannot end its
+// header or start another option.
+static std::string curl_config_value(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '\r' || c == '\n') continue;
+        if (c == '"' || c == '\\') quoted += '\\';
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+static RegistryFetch fetch_registry_url(const std::string& url, const RegistryCacheMeta& cached,
+                                        const fs::path& scratch, std::string& body, RegistryCacheMeta& meta) {
+    fs::path body_path = scratch;
+    body_path += ".body";
+    fs::path header_path = scratch;
+    header_path += ".headers";
+    fs::path config_path = scratch;
+    config_path += ".curlrc";
+    std::error_code ec;
+    fs::remove(body_path, ec);
+    fs::remove(header_path, ec);
+
+    // Server-supplied validators and the URL go through a curl config file, never the shell
+    std::string config;
+    if (!cached.etag.empty()) {
+        config += "header = " + curl_config_value("If-None-Match: " + cached.etag) + "\n";
+    }
+    if (!cached.last_modified.empty()) {
+        config += "header = " + curl_config_value("If-Modified-Since: " + cached.last_modified) + "\n";
+    }
+    config += "dump-header = " + curl_config_value(header_path.string()) + "\n";
+    config += "output = " + curl_config_value(body_path.string()) + "\n";
+    config += "write-out = \"%{http_code}\"\n";
+    config += "url = " + curl_config_value(url) + "\n";
+    if (!write_text_file_atomic(config_path, config)) {
+        return RegistryFetch::Failed;
+    }
+    std::string status = exec_command("curl -s -f -L -K \"" + config_path.string() + "\" 2>/dev/null");
+    fs::remove(config_path, ec);
+
+    RegistryFetch result = RegistryFetch::Failed;
+    if (status == "304") {
+        result = RegistryFetch::NotModified;
+    } else if ((status == "200" || status == "000") && fs::exists(body_path)) {
+        // file:// URLs report 000 on success
+        body = read_text_file(body_path);
+        meta.url = url;
+        parse_validators(read_text_file(header_path), meta);
+        result = body.empty() ? RegistryFetch::Failed : RegistryFetch::Fresh;
+    }
+
+    fs::remove(body_path, ec);
+    fs::remove(header_path, ec);
+    return result;
+}
+
+// Registry index document for a package: revalidated against the cache, or served from it offline
+static bool fetch_registry_document(const std::string& package_name, std::string& json) {
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        auto it = g_registry_documents.find(package_name);
+        if (it != g_registry_documents.end()) {
+            json = it->second;
+            return !json.empty();
         }
     }
-    
-    if (json.empty()) {
+
+    fs::path cache_dir = registry_cache_dir();
+    fs::path doc_path = cache_dir.empty() ? fs::path() : cache_dir / (package_name + ".json");
+    fs::path meta_path = cache_dir.empty() ? fs::path() : cache_dir / (package_name + ".meta");
+    std::string cached = doc_path.empty() ? "" : read_text_file(doc_path);
+
+    auto remember = [&](const std::string& doc) {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        g_registry_documents[package_name] = doc;
+        json = doc;
+        return !doc.empty();
+    };
+
+    if (g_registry_offline) {
+        if (cached.empty()) {
+            std::lock_guard<std::mutex> lock(g_registry_mutex);
+            std::cerr << RED << "Error:" << RESET << " '" << package_name
+                      << "' is not in the registry cache (run once without --offline)" << std::endl;
+        }
+        return remember(cached);
+    }
+
+    // Revalidate where the cached copy came from first, then the flat and sharded layouts
+    RegistryCacheMeta cached_meta = cached.empty() ? RegistryCacheMeta{} : read_cache_meta(meta_path);
+    std::string base = registry_base_url();
+    std::vector<std::string> urls;
+    if (cached_meta.url.rfind(base, 0) == 0) urls.push_back(cached_meta.url);
+    urls.push_back(base + package_name + ".json");
+    if (package_name.length() >= 2) {
+        urls.push_back(base + package_name.substr(0, 2) + "/" + package_name + ".json");
+    }
+
+    fs::path scratch = (cache_dir.empty() ? fs::temp_directory_path() : cache_dir) /
+                       (".fetch-" + std::to_string(getpid()) + "-" +
+                        std::to_string(std::hash<std::string>{}(package_name)));
+    std::error_code ec;
+    fs::create_directories(scratch.parent_path(), ec);
+
+    for (size_t i = 0; i < urls.size(); ++i) {
+        if (i > 0 && urls[i] == urls[0]) continue;
+        std::string body;
+        RegistryCacheMeta meta;
+        // Validators only apply to the URL they were issued for
+        RegistryCacheMeta conditional = urls[i] == cached_meta.url ? cached_meta : RegistryCacheMeta{};
+        RegistryFetch result = fetch_registry_url(urls[i], conditional, scratch, body, meta);
+
+        if (result == RegistryFetch::NotModified && !cached.empty()) {
+            return remember(cached);
+        }
+        if (result == RegistryFetch::Fresh) {
+            if (!doc_path.empty()) {
+                write_text_file_atomic(doc_path, body);
+                write_text_file_atomic(meta_path, format_cache_meta(meta));
+            }
+            return remember(body);
+        }
+    }
+
+    if (!cached.empty()) {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        std::cerr << "  " << YELLOW << "Warning:" << RESET << " Registry unreachable, using cached index for "
+                  << package_name << std::endl;
+    }
+    return remember(cached);
+}
+
+// Revalidate many index documents concurrently so later fetch_package_info calls hit memory
+static void prefetch_registry_documents(const std::vector<std::string>& names) {
+    parallel_for(names.size(), install_workers(), [&](size_t i) {
+        std::string ignored;
+        fetch_registry_document(names[i], ignored);
+    });
+}
+
+bool fetch_package_info(const std::string& package_name, PackageInfo& package_info, const std::string& requested_version) {
+    std::string json;
+    if (!fetch_registry_document(package_name, json)) {
         return false;
     }
-    
-    package_info.name = extract_json_string(json, "name");
-    package_info.repository = extract_json_string(json, "repository");
+
+    RegistryDocument doc;
+    if (!parse_registry_document(json, doc)) {
+        std::cerr << RED << "Error:" << RESET << " Malformed registry entry for '" << package_name << "'" << std::endl;
+        return false;
+    }
+    package_info.name = doc.name;
+    package_info.repository = doc.repository;
     
     if (package_info.name.empty() || package_info.repository.empty()) {
         return false;
@@ -407,8 +597,7 @@ bool fetch_package_info(const std::string& package_name, PackageInfo& package_in
         return false;
     }
 
-    std::vector<std::string> release_objects = extract_release_objects(json);
-    if (release_objects.empty()) {
+    if (doc.releases.empty()) {
         std::cerr << RED << "Error:" << RESET << " Package '" << package_name << "' has no releases in registry" << std::endl;
         return false;
     }
@@ -418,12 +607,7 @@ bool fetch_package_info(const std::string& package_name, PackageInfo& package_in
     RegistryRelease selected;
     bool found = false;
 
-    for (const auto& release_json : release_objects) {
-        RegistryRelease candidate;
-        if (!parse_release(release_json, candidate)) {
-            continue;
-        }
-
+    for (const auto& candidate : doc.releases) {
         if (!requested_version.empty()) {
             if (candidate.version != requested_version) {
                 continue;
@@ -486,7 +670,9 @@ bool fetch_package_info(const std::string& package_name, PackageInfo& package_in
     return true;
 }
 
-bool download_package(const PackageInfo& info, const fs::path& dest) {
+// Clone a package checkout (without .git) into dest. verified reports whether its tree hash
+// matched info.sha256; a mismatch only warns, since the commit pin is what is enforced.
+static bool clone_package(const PackageInfo& info, const fs::path& dest, bool& verified) {
     // Remove trailing slash from repo URL if present
     std::string repo = info.repository;
     if (!repo.empty() && repo.back() == '/') {
@@ -522,25 +708,16 @@ bool download_package(const PackageInfo& info, const fs::path& dest) {
     
     // Verify SHA256 if provided (supply chain security)
     if (!info.sha256.empty()) {
-        // Compute SHA256 of the repo tarball (excluding .git)
-        // Create a clean tarball from the checkout and compute hash
-        std::string hash_cmd = "cd \"" + dest.string() + "\" && "
-            "find . -path ./.git -prune -o -type f -print0 | sort -z | "
-            "xargs -0 sha256sum | sha256sum | cut -d' ' -f1";
-        std::string computed_hash = exec_command(hash_cmd);
-        
-        // Trim whitespace
-        while (!computed_hash.empty() && (computed_hash.back() == '\n' || computed_hash.back() == ' ')) {
-            computed_hash.pop_back();
-        }
-        
-        // For now, skip strict verification and log a warning if mismatched
-        // Full verification requires matching GitHub's tarball format exactly
-        // TODO: Download tarball directly and verify, or use git-archive
-        if (!computed_hash.empty() && computed_hash.length() == 64) {
-            // We'll implement proper tarball verification later
-            // For now, the commit pin provides the security guarantee
+        // Compute SHA256 of the checkout (excluding .git) in-process, hashing files in parallel
+        std::string computed_hash = sha256_tree(dest, install_workers());
+        verified = computed_hash == info.sha256;
+        if (!verified) {
+            // Registry entries may pin the hash of the commit tarball rather than of the tree
+            std::cerr << "  " << YELLOW << "Warning:" << RESET << " Tree hash of " << info.name
+                      << " does not match source.sha256; relying on the commit pin" << std::endl;
         }
+    } else {
+        verified = false;
     }
     
     // Remove .git directory to save space
@@ -552,6 +729,115 @@ bool download_package(const PackageInfo& info, const fs::path& dest) {
     return true;
 }
 
+// Global package store shared by all projects: ~/.coi/store/<sha256> (or $COI_STORE/<sha256>)
+fs::path package_store_dir() {
+    if (const char* override_dir = std::getenv("COI_STORE")) {
+        if (*override_dir) return fs::path(override_dir);
+    }
+    const char* home = std::getenv("HOME");
+    if (!home || !*home) return {};
+    return fs::path(home) / ".coi" / "store";
+}
+
+// Store entry for a package, keyed by its pinned sha256. Empty if the package cannot be stored
+// (no store directory, or a pin that is not a SHA-256 hex digest and so could never verify).
+static fs::path store_entry_path(const PackageInfo& info) {
+    fs::path store = package_store_dir();
+    if (store.empty() || info.sha256.size() != 64) return {};
+    for (char c : info.sha256) {
+        if (!std::isxdigit(static_cast<unsigned char>(c)) || std::isupper(static_cast<unsigned char>(c))) return {};
+    }
+    return store / info.sha256;
+}
+
+// Clone into a private temporary directory and publish it with an atomic rename, so concurrent
+// installs (in this process or others) never observe a partial entry. Only a checkout whose tree
+// hash matches info.sha256 is published, so an entry's content always matches its key; any other
+// checkout is moved to dest instead (installed is set).
+static bool populate_store_entry(const PackageInfo& info, const fs::path& entry, const fs::path& dest, bool& installed) {
+    std::error_code ec;
+    fs::create_directories(entry.parent_path(), ec);
+    std::ostringstream tmp_name;
+    tmp_name << ".tmp-" << entry.filename().string() << "-" << std::this_thread::get_id() << "-" << getpid();
+    fs::path tmp = entry.parent_path() / tmp_name.str();
+    
+    bool verified = false;
+    if (!clone_package(info, tmp, verified)) {
+        fs::remove_all(tmp, ec);
+        return false;
+    }
+    if (!verified) {
+        installed = true;
+        fs::rename(tmp, dest, ec);
+        if (ec) {
+            ec.clear();
+            fs::copy(tmp, dest, fs::copy_options::recursive, ec);
+            std::error_code remove_ec;
+            fs::remove_all(tmp, remove_ec);
+        }
+        return !ec;
+    }
+    fs::rename(tmp, entry, ec);
+    if (ec) {
+        fs::remove_all(tmp, ec);
+        return fs::exists(entry);
+    }
+    return true;
+}
+
+// Mirror a store entry into a project: hard links where possible, copies across filesystems
+static bool link_tree(const fs::path& from, const fs::path& to) {
+    std::error_code ec;
+    fs::create_directories(to, ec);
+    if (ec) return false;
+    for (auto it = fs::recursive_directory_iterator(from, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        fs::path target = to / it->path().lexically_relative(from);
+        auto type = it->symlink_status().type();
+        if (type == fs::file_type::directory) {
+            fs::create_directories(target, ec);
+        } else if (type == fs::file_type::regular) {
+            fs::create_hard_link(it->path(), target, ec);
+            if (ec) {
+                ec.clear();
+                fs::copy_file(it->path(), target, fs::copy_options::overwrite_existing, ec);
+            }
+        } else if (type == fs::file_type::symlink) {
+            fs::copy_symlink(it->path(), target, ec);
+        }
+        if (ec) return false;
+    }
+    return !ec;
+}
+
+bool download_package(const PackageInfo& info, const fs::path& dest) {
+    // If destination exists, remove it first
+    if (fs::exists(dest)) {
+        fs::remove_all(dest);
+    }
+    
+    fs::path entry = store_entry_path(info);
+    if (entry.empty()) {
+        bool verified = false;
+        return clone_package(info, dest, verified);
+    }
+    
+    // Repeat installs of the same pinned release are served from the store without network access
+    if (!fs::exists(entry)) {
+        bool installed = false;
+        if (!populate_store_entry(info, entry, dest, installed)) {
+            return false;
+        }
+        if (installed) {
+            return true;
+        }
+    }
+    if (!link_tree(entry, dest)) {
+        std::cerr << RED << "Error:" << RESET << " Failed to link " << info.name << " from package store " << entry.string() << std::endl;
+        return false;
+    }
+    return true;
+}
+
 int add_package(const std::string& package_name, const std::string& version) {
     print_pkg_banner("add");
     std::cout << std::endl;
@@ -648,6 +934,14 @@ int install_packages() {
     int current_pond = get_current_compiler_pond();
     int current_drop = get_current_compiler_drop();
     
+    // Check installed state and compatibility serially, then clone and verify the rest concurrently
+    struct PendingInstall {
+        std::string name;
+        PackageInfo info;
+        fs::path dest;
+    };
+    std::vector<PendingInstall> pending;
+    
     for (const auto& [name, entry] : packages) {
         fs::path pkg_dest = pkgs_dir / name;
         fs::create_directories(pkg_dest.parent_path());
@@ -658,8 +952,6 @@ int install_packages() {
             skipped++;
             continue;
         }
-        
-        std::cout << "  " << DIM << "Installing " << name << "@" << entry.version << "..." << RESET << std::endl;
 
         if (entry.pond >= 0 && entry.min_drop > 0) {
             if (entry.pond != current_pond) {
@@ -690,15 +982,28 @@ int install_packages() {
         info.min_drop = entry.min_drop;
         info.commit = entry.commit;
         info.sha256 = entry.sha256;
+        pending.push_back({name, info, pkg_dest});
+    }
+    
+    if (!pending.empty()) {
+        unsigned workers = std::min<unsigned>(install_workers(), static_cast<unsigned>(pending.size()));
+        std::cout << "  " << DIM << "Installing " << pending.size() << " package(s) (" << workers << " parallel)..." << RESET << std::endl;
+    }
+    
+    std::mutex output_mutex;
+    parallel_for(pending.size(), install_workers(), [&](size_t i) {
+        const auto& job = pending[i];
+        bool ok = download_package(job.info, job.dest);
         
-        if (download_package(info, pkg_dest)) {
-            std::cout << "  " << GREEN << "✓" << RESET << " " << name << "@" << entry.version << std::endl;
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (ok) {
+            std::cout << "  " << GREEN << "✓" << RESET << " " << job.name << "@" << job.info.version << std::endl;
             installed++;
         } else {
-            std::cerr << "  " << RED << "✗" << RESET << " Failed to install " << name << std::endl;
+            std::cerr << "  " << RED << "✗" << RESET << " Failed to install " << job.name << std::endl;
             failed++;
         }
-    }
+    });
     
     std::cout << std::endl;
     if (failed == 0) {
@@ -884,6 +1189,12 @@ int update_all_packages() {
     int updated = 0;
     int up_to_date = 0;
     int failed = 0;
+
+    std::vector<std::string> names;
+    for (const auto& [name, entry] : packages) {
+        names.push_back(name);
+    }
+    prefetch_registry_documents(names);
     
     for (auto& [name, entry] : packages) {
         std::cout << "  " << DIM << "Checking " << name << "..." << RESET << std::endl;
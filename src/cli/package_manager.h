@@ -66,4 +66,11 @@ bool write_lock_file(const fs::path& lock_path, const std::map<std::string, Lock
 bool fetch_package_info(const std::string& package_name, PackageInfo& package_info, const std::string& version = "");
 
 // Download/clone a package to destination
+// Pinned releases are cloned once into the global package store and linked into dest
 bool download_package(const PackageInfo& info, const fs::path& dest);
+
+// Global package store directory ($COI_STORE, or ~/.coi/store); empty if it cannot be determined
+fs::path package_store_dir();
+
+// Resolve registry lookups from the local index cache only (--offline)
+void set_registry_offline(bool offline);
@@ -0,0 +1,236 @@
+#include "release.h"
+#include "cli.h"
+#include "sha256.h"
+#include <brotli/encode.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace colors;
+
+std::string gzip_compress(const std::string& data) {
+    z_stream stream{};
+    // windowBits 15 + 16 selects the gzip wrapper; memLevel 9 is zlib's maximum
+    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15 + 16, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return "";
+    }
+
+    std::string out(deflateBound(&stream, data.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(out.data());
+    stream.avail_out = static_cast<uInt>(out.size());
+
+    int ret = deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return ret == Z_STREAM_END ? out : "";
+}
+
+std::string brotli_compress(const std::string& data, bool text) {
+    size_t encoded_size = BrotliEncoderMaxCompressedSize(data.size());
+    if (encoded_size == 0) return "";
+
+    std::string out(encoded_size, '\0');
+    BrotliEncoderMode mode = text ? BROTLI_MODE_TEXT : BROTLI_MODE_GENERIC;
+    if (!BrotliEncoderCompress(BROTLI_MAX_QUALITY, BROTLI_MAX_WINDOW_BITS, mode,
+                               data.size(), reinterpret_cast<const uint8_t*>(data.data()),
+                               &encoded_size, reinterpret_cast<uint8_t*>(out.data()))) {
+        return "";
+    }
+    out.resize(encoded_size);
+    return out;
+}
+
+static bool read_file(const fs::path& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+static bool write_file(const fs::path& path, const std::string& data) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+    file << data;
+    return static_cast<bool>(file);
+}
+
+// Replace references to `from` that are not part of a longer file name; returns the count
+static int rewrite_reference(std::string& text, const std::string& from, const std::string& to) {
+    auto is_name_char = [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-' || c == '.';
+    };
+
+    int count = 0;
+    size_t pos = 0;
+    while ((pos = text.find(from, pos)) != std::string::npos) {
+        size_t end = pos + from.size();
+        bool bounded = (pos == 0 || !is_name_char(text[pos - 1])) &&
+                       (end == text.size() || !is_name_char(text[end]) ||
+                        (text[end] == '.' && (end + 1 == text.size() || !is_name_char(text[end + 1]))));
+        if (bounded) {
+            text.replace(pos, from.size(), to);
+            pos += to.size();
+            count++;
+        } else {
+            pos = end;
+        }
+    }
+    return count;
+}
+
+static std::string hashed_name(const std::string& stem, const std::string& ext, const std::string& data) {
+    return stem + "." + sha256_hex(data).substr(0, 10) + ext;
+}
+
+static std::string format_size(size_t bytes) {
+    std::ostringstream out;
+    if (bytes < 1024) {
+        out << bytes << " B";
+    } else {
+        out.setf(std::ios::fixed);
+        out.precision(1);
+        out << (bytes / 1024.0) << " KB";
+    }
+    return out.str();
+}
+
+void remove_release_artifacts(const fs::path& dist_dir) {
+    static const std::regex release_file(
+        R"((app\.[0-9a-f]{10}\.(wasm|js|css)|app\.(wasm|js|css)|route-.+\.css|index\.html)(\.br|\.gz)|app\.[0-9a-f]{10}\.(wasm|js|css)|release-manifest\.json)");
+
+    std::error_code ec;
+    if (!fs::is_directory(dist_dir, ec)) return;
+    for (const auto& entry : fs::directory_iterator(dist_dir, ec)) {
+        std::string name = entry.path().filename().string();
+        if (entry.is_regular_file(ec) && std::regex_match(name, release_file)) {
+            fs::remove(entry.path(), ec);
+        }
+    }
+}
+
+bool write_release_artifacts(const fs::path& dist_dir) {
+    struct Artifact {
+        std::string logical;  // Name before fingerprinting (app.js, ...)
+        std::string file;     // Name written to dist/
+        std::string data;
+        bool text = true;
+        std::string gzip = {};
+        std::string brotli = {};
+    };
+
+    std::string html, js, css, wasm;
+    if (!read_file(dist_dir / "index.html", html) || !read_file(dist_dir / "app.js", js)) {
+        std::cerr << RED << "Error:" << RESET << " Release output needs dist/index.html and dist/app.js" << std::endl;
+        return false;
+    }
+    bool has_css = read_file(dist_dir / "app.css", css);
+    bool has_wasm = read_file(dist_dir / "app.wasm", wasm);
+
+    // Fingerprint leaves first: the JS loader embeds the wasm name, and the HTML embeds the others.
+    // A file is only renamed when something actually references it, so unknown loaders keep working.
+    std::vector<Artifact> artifacts;
+    if (has_wasm) {
+        std::string wasm_name = hashed_name("app", ".wasm", wasm);
+        if (rewrite_reference(js, "app.wasm", wasm_name) == 0) {
+            std::cerr << YELLOW << "Warning:" << RESET << " app.js does not reference app.wasm; keeping its name" << std::endl;
+            wasm_name = "app.wasm";
+        }
+        rewrite_reference(html, "app.wasm", wasm_name);
+        artifacts.push_back({"app.wasm", wasm_name, std::move(wasm), false});
+    }
+
+    std::string js_name = hashed_name("app", ".js", js);
+    if (rewrite_reference(html, "app.js", js_name) == 0) {
+        js_name = "app.js";
+    }
+    artifacts.push_back({"app.js", js_name, std::move(js), true});
+
+    if (has_css) {
+        std::string css_name = hashed_name("app", ".css", css);
+        if (rewrite_reference(html, "app.css", css_name) == 0) {
+            css_name = "app.css";
+        }
+        artifacts.push_back({"app.css", css_name, std::move(css), true});
+    }
+    artifacts.push_back({"index.html", "index.html", std::move(html), true});
+
+    // Route stylesheets are fingerprinted by the compiler (route-<Component>.<hash>.css), since the
+    // wasm binary embeds their names and rewriting one inside it would change data segment lengths
+    static const std::regex hashed_route_sheet(R"((route-.+)\.[0-9a-f]{10}\.css)");
+    std::vector<fs::path> route_sheets;
+    for (const auto& entry : fs::directory_iterator(dist_dir)) {
+        std::string name = entry.path().filename().string();
+        if (entry.is_regular_file() && name.rfind("route-", 0) == 0 && entry.path().extension() == ".css") {
+            route_sheets.push_back(entry.path());
+        }
+    }
+    std::sort(route_sheets.begin(), route_sheets.end());
+    for (const auto& path : route_sheets) {
+        std::string data;
+        std::string name = path.filename().string();
+        std::smatch match;
+        std::string logical = std::regex_match(name, match, hashed_route_sheet) ? match[1].str() + ".css" : name;
+        if (read_file(path, data)) {
+            artifacts.push_back({logical, name, std::move(data), true});
+        }
+    }
+
+    unsigned workers = std::clamp(std::thread::hardware_concurrency(), 1u, 8u);
+    parallel_for(artifacts.size(), workers, [&](size_t i) {
+        Artifact& artifact = artifacts[i];
+        artifact.gzip = gzip_compress(artifact.data);
+        artifact.brotli = brotli_compress(artifact.data, artifact.text);
+    });
+
+    for (const auto& artifact : artifacts) {
+        if (artifact.file != artifact.logical) {
+            fs::remove(dist_dir / artifact.logical);
+        }
+        if (!write_file(dist_dir / artifact.file, artifact.data)) {
+            std::cerr << RED << "Error:" << RESET << " Could not write " << artifact.file << std::endl;
+            return false;
+        }
+        // Precompressed siblings are only useful when they are actually smaller
+        if (!artifact.gzip.empty() && artifact.gzip.size() < artifact.data.size()) {
+            write_file(dist_dir / (artifact.file + ".gz"), artifact.gzip);
+        }
+        if (!artifact.brotli.empty() && artifact.brotli.size() < artifact.data.size()) {
+            write_file(dist_dir / (artifact.file + ".br"), artifact.brotli);
+        }
+    }
+
+    std::ofstream manifest(dist_dir / "release-manifest.json");
+    manifest << "{\n  \"files\": {\n";
+    for (size_t i = 0; i < artifacts.size(); ++i) {
+        const auto& artifact = artifacts[i];
+        manifest << "    \"" << artifact.logical << "\": {\n";
+        manifest << "      \"file\": \"" << artifact.file << "\",\n";
+        manifest << "      \"immutable\": " << (artifact.file != artifact.logical ? "true" : "false") << ",\n";
+        manifest << "      \"bytes\": " << artifact.data.size() << ",\n";
+        manifest << "      \"gzip\": " << artifact.gzip.size() << ",\n";
+        manifest << "      \"brotli\": " << artifact.brotli.size() << "\n";
+        manifest << "    }" << (i + 1 < artifacts.size() ? "," : "") << "\n";
+    }
+    manifest << "  }\n}\n";
+    if (!manifest) {
+        std::cerr << RED << "Error:" << RESET << " Could not write release-manifest.json" << std::endl;
+        return false;
+    }
+
+    for (const auto& artifact : artifacts) {
+        std::cout << "  " << DIM << artifact.file << RESET << "  " << format_size(artifact.data.size())
+                  << DIM << " → br " << format_size(artifact.brotli.size())
+                  << ", gz " << format_size(artifact.gzip.size()) << RESET << std::endl;
+    }
+    return true;
+}
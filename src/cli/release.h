@@ -0,0 +1,23 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+// Production output stage for a finished build in dist_dir:
+// - app.wasm, app.js and app.css are renamed to app.<hash>.<ext> and references to them in
+//   app.js and index.html are rewritten, so the hashed files can be cached forever
+// - route-*.css sheets keep their names (the wasm references them) but are compressed too
+// - every artifact gets .br (brotli, quality 11) and .gz (zlib, level 9) siblings when smaller
+// - release-manifest.json lists each artifact with its raw, gzip and brotli sizes
+// Returns true on success
+bool write_release_artifacts(const fs::path& dist_dir);
+
+// Remove fingerprinted files, compressed siblings and the manifest left by a previous
+// release build, so a plain build never leaves stale .br/.gz copies next to fresh files
+void remove_release_artifacts(const fs::path& dist_dir);
+
+// In-process compressors at maximum level; empty string on failure
+std::string gzip_compress(const std::string& data);
+std::string brotli_compress(const std::string& data, bool text);
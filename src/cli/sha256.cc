@@ -0,0 +1,152 @@
+#include "sha256.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+Sha256::Sha256()
+    : state_{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19} {}
+
+void Sha256::compress(const uint8_t* block) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) |
+               (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+    }
+    for (int i = 16; i < 64; ++i) {
+        uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+    uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+    for (int i = 0; i < 64; ++i) {
+        uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+        uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state_[0] += a; state_[1] += b; state_[2] += c; state_[3] += d;
+    state_[4] += e; state_[5] += f; state_[6] += g; state_[7] += h;
+}
+
+void Sha256::update(const void* data, size_t len) {
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    total_len_ += len;
+    if (buffer_len_ > 0) {
+        size_t take = std::min(len, sizeof(buffer_) - buffer_len_);
+        std::memcpy(buffer_ + buffer_len_, p, take);
+        buffer_len_ += take;
+        p += take;
+        len -= take;
+        if (buffer_len_ < sizeof(buffer_)) return;
+        compress(buffer_);
+        buffer_len_ = 0;
+    }
+    for (; len >= 64; p += 64, len -= 64) {
+        compress(p);
+    }
+    std::memcpy(buffer_, p, len);
+    buffer_len_ = len;
+}
+
+std::array<uint8_t, 32> Sha256::finish() {
+    uint64_t bit_len = total_len_ * 8;
+    uint8_t pad = 0x80;
+    update(&pad, 1);
+    uint8_t zero = 0;
+    while (buffer_len_ != 56) {
+        update(&zero, 1);
+    }
+    uint8_t len_bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        len_bytes[i] = uint8_t(bit_len >> (56 - i * 8));
+    }
+    update(len_bytes, 8);
+
+    std::array<uint8_t, 32> digest;
+    for (int i = 0; i < 8; ++i) {
+        digest[i * 4] = uint8_t(state_[i] >> 24);
+        digest[i * 4 + 1] = uint8_t(state_[i] >> 16);
+        digest[i * 4 + 2] = uint8_t(state_[i] >> 8);
+        digest[i * 4 + 3] = uint8_t(state_[i]);
+    }
+    return digest;
+}
+
+std::string Sha256::to_hex(const std::array<uint8_t, 32>& digest) {
+    static const char* hex = "0123456789abcdef";
+    std::string out;
+    out.reserve(64);
+    for (uint8_t byte : digest) {
+        out += hex[byte >> 4];
+        out += hex[byte & 0xf];
+    }
+    return out;
+}
+
+std::string sha256_hex(const std::string& data) {
+    Sha256 hasher;
+    hasher.update(data.data(), data.size());
+    return Sha256::to_hex(hasher.finish());
+}
+
+std::string sha256_file(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return "";
+
+    Sha256 hasher;
+    char chunk[64 * 1024];
+    while (file) {
+        file.read(chunk, sizeof(chunk));
+        hasher.update(chunk, static_cast<size_t>(file.gcount()));
+    }
+    if (file.bad()) return "";
+    return Sha256::to_hex(hasher.finish());
+}
+
+std::string sha256_tree(const fs::path& root, unsigned threads) {
+    // Relative paths in `find .` form, skipping the top-level .git directory
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(root, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (it.depth() == 0 && it->path().filename() == ".git") {
+            it.disable_recursion_pending();
+            continue;
+        }
+        if (it->symlink_status().type() == fs::file_type::regular) {
+            files.push_back("./" + it->path().lexically_relative(root).generic_string());
+        }
+    }
+    if (ec) return "";
+    std::sort(files.begin(), files.end());
+
+    std::vector<std::string> digests(files.size());
+    parallel_for(files.size(), threads, [&](size_t i) {
+        digests[i] = sha256_file(root / files[i].substr(2));
+    });
+
+    // sha256sum manifest: "<digest>  <path>\n" per file, hashed again
+    Sha256 manifest;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (digests[i].empty()) return "";
+        std::string line = digests[i] + "  " + files[i] + "\n";
+        manifest.update(line.data(), line.size());
+    }
+    return Sha256::to_hex(manifest.finish());
+}
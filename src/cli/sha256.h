@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Streaming SHA-256 (FIPS 180-4)
+class Sha256 {
+public:
+    Sha256();
+    void update(const void* data, size_t len);
+    std::array<uint8_t, 32> finish();
+
+    static std::string to_hex(const std::array<uint8_t, 32>& digest);
+
+private:
+    void compress(const uint8_t* block);
+
+    uint32_t state_[8];
+    uint8_t buffer_[64];
+    size_t buffer_len_ = 0;
+    uint64_t total_len_ = 0;
+};
+
+// Hex digest of a string
+std::string sha256_hex(const std::string& data);
+
+// Hex digest of a file, streamed in chunks. Returns "" if the file cannot be read.
+std::string sha256_file(const fs::path& path);
+
+// Hex digest of a checkout, identical to
+//   find . -path ./.git -prune -o -type f -print0 | sort -z | xargs -0 sha256sum | sha256sum
+// run from root. Files are hashed on up to `threads` workers. Returns "" if a file cannot be read.
+std::string sha256_tree(const fs::path& root, unsigned threads);
+
+// Set on parallel_for worker threads
+inline thread_local bool in_parallel_worker = false;
+
+// Run fn(0..count-1) on at most `workers` threads (inline when a single worker suffices). A
+// parallel_for started from a worker runs inline, so nested pools never multiply the thread count.
+inline void parallel_for(size_t count, unsigned workers, const std::function<void(size_t)>& fn) {
+    if (workers > count) workers = static_cast<unsigned>(count);
+    if (workers <= 1 || in_parallel_worker) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> pool;
+    for (unsigned w = 0; w < workers; ++w) {
+        pool.emplace_back([&]() {
+            in_parallel_worker = true;
+            for (size_t i = next++; i < count; i = next++) fn(i);
+        });
+    }
+    for (auto& t : pool) t.join();
+}
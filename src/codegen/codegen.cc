@@ -3,17 +3,29 @@
 #include "../analysis/feature_detector.h"
 #include "../analysis/dependency_resolver.h"
 #include "json_codegen.h"
+#include "css_generator.h"
+#include "tree_shaker.h"
+#include "heap_codegen.h"
+#include "trace_codegen.h"
+#include "../ast/codegen_state.h"
 #include <iostream>
 
 void generate_cpp_code(
-    std::ostream &out,
+    std::ostream &target,
     std::vector<Component> &all_components,
     const std::vector<std::unique_ptr<DataDef>> &all_global_data,
     const std::vector<std::unique_ptr<EnumDef>> &all_global_enums,
     const AppConfig &final_app_config,
     const std::set<std::string> &required_headers,
-    const FeatureFlags &features)
+    const FeatureFlags &features,
+    const std::vector<RouteStylesheet> &route_sheets,
+    bool debug_build,
+    const TraceOptions &trace)
 {
+    // Everything is generated into a buffer first; tree_shake() then drops the components,
+    // methods, updaters, types and JSON metadata that nothing reachable from main() uses
+    std::stringstream out;
+
     // Include required headers
     for (const auto &header : required_headers)
     {
@@ -29,6 +41,15 @@ void generate_cpp_code(
     out << "#include \"webcc/core/random.h\"\n";
     out << "#include \"webcc/core/math.h\"\n";
     out << "\n";
+
+    // Coi-owned allocations use the app's allocator when one is selected
+    g_heap_allocator = final_app_config.allocator;
+    if (!g_heap_allocator.empty())
+    {
+        emit_heap_runtime(out, g_heap_allocator);
+        out << "\n";
+    }
+
     out << "namespace coi {\n";
     out << "using string = webcc::string;\n";
     out << "using string_view = webcc::string_view;\n";
@@ -37,7 +58,15 @@ void generate_cpp_code(
     out << "template<typename K, typename V> using map = webcc::unordered_map<K, V>;\n";
     out << "template<typename Signature> using function = webcc::function<Signature>;\n";
     out << "using webcc::move;\n";
-    out << "using webcc::malloc;\n";
+    if (g_heap_allocator.empty())
+    {
+        out << "using webcc::malloc;\n";
+    }
+    else
+    {
+        out << "inline void* malloc(size_t size) { return __coi_heap::heap.alloc((uint32_t)size); }\n";
+        out << "inline void free(void* ptr) { __coi_heap::heap.free(ptr); }\n";
+    }
     out << "namespace math {\n";
     out << "inline constexpr float PI = webcc::PI;\n";
     out << "inline constexpr float HALF_PI = webcc::HALF_PI;\n";
@@ -52,6 +81,124 @@ void generate_cpp_code(
     out << "}\n";
     out << "}\n";
 
+    // Scratch memory for temporaries that only live until the end of the frame (pending DOM write
+    // values, JSON unescaping). Allocation bumps a pointer; reset() rewinds it after each frame's
+    // flush. A frame that outgrows the static block moves on to overflow chunks, which are kept
+    // for later frames, so a steady workload stops touching the heap after its first peak. A single
+    // large temporary (a long JSON string) gets a block of its own, freed at reset(), so one spike
+    // does not pin a chunk of its size for the rest of the session.
+    out << "template<uint32_t InitialSize = 16384>\n";
+    out << "struct FrameArena {\n";
+    out << "    struct Chunk { Chunk* next; uint32_t capacity; };\n";
+    out << "    alignas(16) unsigned char initial[InitialSize];\n";
+    out << "    unsigned char* base = initial;\n";
+    out << "    uint32_t capacity = InitialSize;\n";
+    out << "    uint32_t offset = 0;\n";
+    out << "    Chunk* chunks = nullptr;\n";
+    out << "    Chunk* tail = nullptr;\n";
+    out << "    Chunk* current = nullptr;\n";
+    out << "    Chunk* large = nullptr;\n";
+    out << "    uint32_t frame_bytes = 0;\n";
+    out << "    uint32_t high_water = 0;\n";
+    out << "    void* alloc(uint32_t size) {\n";
+    out << "        size = (size + 7) & ~7u;\n";
+    out << "        if (size > InitialSize / 4) return alloc_large(size);\n";
+    out << "        if (offset + size > capacity) next_chunk(size);\n";
+    out << "        void* p = base + offset;\n";
+    out << "        offset += size;\n";
+    out << "        frame_bytes += size;\n";
+    out << "        return p;\n";
+    out << "    }\n";
+    // Large blocks are returned at reset(): through the app's allocator when there is one, otherwise
+    // through operator new/delete (webcc's malloc has no matching free)
+    std::string large_alloc = g_heap_allocator.empty() ? "::operator new" : "coi::malloc";
+    std::string large_free = g_heap_allocator.empty() ? "::operator delete" : "coi::free";
+    out << "    void* alloc_large(uint32_t size) {\n";
+    out << "        Chunk* c = (Chunk*)" << large_alloc << "(sizeof(Chunk) + 16 + size);\n";
+    out << "        c->next = large;\n";
+    out << "        c->capacity = size;\n";
+    out << "        large = c;\n";
+    out << "        frame_bytes += size;\n";
+    out << "        return (void*)(((uintptr_t)(c + 1) + 15) & ~(uintptr_t)15);\n";
+    out << "    }\n";
+    out << "    Chunk* add_chunk(uint32_t size) {\n";
+    out << "        uint32_t cap = size > InitialSize ? size : InitialSize;\n";
+    out << "        Chunk* c = (Chunk*)coi::malloc(sizeof(Chunk) + 16 + cap);\n";
+    out << "        c->next = nullptr;\n";
+    out << "        c->capacity = cap;\n";
+    out << "        if (tail) tail->next = c; else chunks = c;\n";
+    out << "        tail = c;\n";
+    out << "        return c;\n";
+    out << "    }\n";
+    out << "    void next_chunk(uint32_t size) {\n";
+    out << "        Chunk* c = current ? current->next : chunks;\n";
+    out << "        while (c && c->capacity < size) c = c->next;\n";
+    out << "        current = c ? c : add_chunk(size);\n";
+    out << "        base = (unsigned char*)(((uintptr_t)(current + 1) + 15) & ~(uintptr_t)15);\n";
+    out << "        capacity = current->capacity;\n";
+    out << "        offset = 0;\n";
+    out << "    }\n";
+    out << "    const char* copy(const char* s) {\n";
+    out << "        uint32_t n = 0;\n";
+    out << "        while (s[n]) n++;\n";
+    out << "        char* d = (char*)alloc(n + 1);\n";
+    out << "        for (uint32_t i = 0; i <= n; i++) d[i] = s[i];\n";
+    out << "        return d;\n";
+    out << "    }\n";
+    out << "    void reserve(int32_t size) {\n";
+    out << "        if (size <= (int32_t)InitialSize) return;\n";
+    out << "        for (Chunk* c = chunks; c; c = c->next) if (c->capacity >= (uint32_t)size) return;\n";
+    out << "        add_chunk((uint32_t)size);\n";
+    out << "    }\n";
+    out << "    void reset() {\n";
+    out << "        if (frame_bytes > high_water) high_water = frame_bytes;\n";
+    out << "        frame_bytes = 0;\n";
+    out << "        while (large) {\n";
+    out << "            Chunk* next = large->next;\n";
+    out << "            " << large_free << "(large);\n";
+    out << "            large = next;\n";
+    out << "        }\n";
+    out << "        current = nullptr;\n";
+    out << "        base = initial;\n";
+    out << "        capacity = InitialSize;\n";
+    out << "        offset = 0;\n";
+    out << "    }\n";
+    out << "};\n";
+    out << "FrameArena<> g_frame;\n\n";
+
+    g_debug_build = debug_build;
+    if (g_debug_build)
+    {
+        emit_memory_telemetry_runtime(out);
+        out << "\n";
+    }
+
+    g_callback_tables.clear();
+    if (features.timers)
+        g_callback_tables.push_back("g_timers");
+    if (features.fetch)
+    {
+        g_callback_tables.push_back("g_fetch_success_dispatcher");
+        g_callback_tables.push_back("g_fetch_error_dispatcher");
+    }
+    if (features.websocket)
+    {
+        g_callback_tables.push_back("g_ws_message_dispatcher");
+        g_callback_tables.push_back("g_ws_open_dispatcher");
+        g_callback_tables.push_back("g_ws_close_dispatcher");
+        g_callback_tables.push_back("g_ws_error_dispatcher");
+        g_callback_tables.push_back("g_ws_receive_dispatcher");
+    }
+
+    // Event trace recorder or player (--record / --replay)
+    g_trace_record = trace.record;
+    g_trace_replay = !trace.replay.empty();
+    if (g_trace_record || g_trace_replay)
+    {
+        emit_trace_runtime(out, trace);
+        out << "\n";
+    }
+
     // Sort components topologically so dependencies come first
     auto sorted_components = topological_sort_components(all_components);
 
@@ -89,23 +236,49 @@ void generate_cpp_code(
         }
     }
 
-    // Generic event dispatcher template (only if needed)
+    // Route sheets are attached at startup with a media query that matches nothing, so they download
+    // in the background; a route enables its sheet when it activates (see plan_route_stylesheets)
+    g_route_stylesheets.clear();
+    for (size_t i = 0; i < route_sheets.size(); ++i)
+    {
+        g_route_stylesheets[route_sheets[i].route_component] = "g_route_css_" + std::to_string(i);
+    }
+
+    // Generic event dispatcher template (only if needed). Every entry is tagged with the
+    // component instance that registered it, so a torn-down component drops all of its
+    // handlers in one pass (remove_owner) instead of one lookup per element. Debug builds
+    // also report the table to __coi_mem (see emit_memory_telemetry_runtime), so a torn-down
+    // component can audit for handlers it or other code left behind.
     if (needs_dispatcher(features))
     {
         out << "template<typename Callback, int MaxListeners = 64>\n";
         out << "struct Dispatcher {\n";
         out << "    int32_t handles[MaxListeners];\n";
         out << "    Callback callbacks[MaxListeners];\n";
+        out << "    const void* owners[MaxListeners];\n";
         out << "    int count = 0;\n";
-        out << "    void set(webcc::handle h, Callback cb) {\n";
+        if (g_debug_build)
+        {
+            out << "    __coi_mem::DispatcherTable audit;\n";
+            out << "    explicit Dispatcher(const char* name, bool elements = true)\n";
+            out << "        : audit(name, elements, handles, owners, &count, MaxListeners) {}\n";
+        }
+        out << "    void set(webcc::handle h, Callback cb, const void* owner = nullptr) {\n";
         out << "        int32_t hid = (int32_t)h;\n";
         out << "        for (int i = 0; i < count; i++) {\n";
-        out << "            if (handles[i] == hid) { callbacks[i] = cb; return; }\n";
+        out << "            if (handles[i] == hid) { callbacks[i] = cb; owners[i] = owner; return; }\n";
         out << "        }\n";
         out << "        if (count < MaxListeners) {\n";
         out << "            handles[count] = hid;\n";
         out << "            callbacks[count] = cb;\n";
+        out << "            owners[count] = owner;\n";
         out << "            count++;\n";
+        if (g_debug_build)
+        {
+            out << "            audit.grew();\n";
+            out << "        } else {\n";
+            out << "            audit.full();\n";
+        }
         out << "        }\n";
         out << "    }\n";
         out << "    void remove(webcc::handle h) {\n";
@@ -114,11 +287,45 @@ void generate_cpp_code(
         out << "            if (handles[i] == hid) {\n";
         out << "                handles[i] = handles[count-1];\n";
         out << "                callbacks[i] = callbacks[count-1];\n";
+        out << "                owners[i] = owners[count-1];\n";
         out << "                count--;\n";
         out << "                return;\n";
         out << "            }\n";
         out << "        }\n";
         out << "    }\n";
+        out << "    // Drop every entry registered by owner, keeping the others in order\n";
+        out << "    void remove_owner(const void* owner) {\n";
+        out << "        int kept = 0;\n";
+        out << "        for (int i = 0; i < count; i++) {\n";
+        out << "            if (owners[i] == owner) continue;\n";
+        out << "            if (kept != i) {\n";
+        out << "                handles[kept] = handles[i];\n";
+        out << "                callbacks[kept] = callbacks[i];\n";
+        out << "                owners[kept] = owners[i];\n";
+        out << "            }\n";
+        out << "            kept++;\n";
+        out << "        }\n";
+        out << "        count = kept;\n";
+        out << "    }\n";
+        out << "    bool contains(webcc::handle h) {\n";
+        out << "        int32_t hid = (int32_t)h;\n";
+        out << "        for (int i = 0; i < count; i++) if (handles[i] == hid) return true;\n";
+        out << "        return false;\n";
+        out << "    }\n";
+        out << "    bool take(webcc::handle h, Callback& out) {\n";
+        out << "        int32_t hid = (int32_t)h;\n";
+        out << "        for (int i = 0; i < count; i++) {\n";
+        out << "            if (handles[i] == hid) {\n";
+        out << "                out = callbacks[i];\n";
+        out << "                handles[i] = handles[count-1];\n";
+        out << "                callbacks[i] = callbacks[count-1];\n";
+        out << "                owners[i] = owners[count-1];\n";
+        out << "                count--;\n";
+        out << "                return true;\n";
+        out << "            }\n";
+        out << "        }\n";
+        out << "        return false;\n";
+        out << "    }\n";
         out << "    template<typename... Args>\n";
         out << "    bool dispatch(webcc::handle h, Args&&... args) {\n";
         out << "        int32_t hid = (int32_t)h;\n";
@@ -130,6 +337,76 @@ void generate_cpp_code(
         out << "};\n\n";
     }
 
+    // Reactive DOM writes wait in a buffer until the next flush. A later write to the same element
+    // slot (text, inner HTML, or a named attribute/property) replaces the pending one, and removing
+    // an element drops its pending writes, so each flush sends at most one write per slot.
+    out << "template<int Capacity = 256>\n";
+    out << "struct DomWriteBuffer {\n";
+    out << "    enum Kind : uint8_t { Text, Html, Attribute, Property };\n";
+    out << "    webcc::handle handles[Capacity];\n";
+    out << "    Kind kinds[Capacity];\n";
+    out << "    const char* names[Capacity];\n";
+    out << "    const char* values[Capacity];\n";
+    out << "    int count = 0;\n";
+    out << "    static bool same_name(const char* a, const char* b) {\n";
+    out << "        if (a == b) return true;\n";
+    out << "        if (!a || !b) return false;\n";
+    out << "        while (*a && *a == *b) { a++; b++; }\n";
+    out << "        return *a == *b;\n";
+    out << "    }\n";
+    out << "    void write(webcc::handle h, Kind kind, const char* name, const char* value) {\n";
+    out << "        int32_t hid = (int32_t)h;\n";
+    out << "        for (int i = 0; i < count; i++) {\n";
+    out << "            if ((int32_t)handles[i] == hid && kinds[i] == kind && same_name(names[i], name)) {\n";
+    out << "                values[i] = g_frame.copy(value);\n";
+    out << "                return;\n";
+    out << "            }\n";
+    out << "        }\n";
+    out << "        if (count == Capacity) commit();\n";
+    out << "        handles[count] = h;\n";
+    out << "        kinds[count] = kind;\n";
+    out << "        names[count] = name;\n";
+    out << "        values[count] = g_frame.copy(value);\n";
+    out << "        count++;\n";
+    out << "    }\n";
+    out << "    void text(webcc::handle h, const char* value) { write(h, Text, nullptr, value); }\n";
+    out << "    void html(webcc::handle h, const char* value) { write(h, Html, nullptr, value); }\n";
+    out << "    void attribute(webcc::handle h, const char* name, const char* value) { write(h, Attribute, name, value); }\n";
+    out << "    void property(webcc::handle h, const char* name, const char* value) { write(h, Property, name, value); }\n";
+    out << "    void remove(webcc::handle h) {\n";
+    out << "        int32_t hid = (int32_t)h;\n";
+    out << "        int kept = 0;\n";
+    out << "        for (int i = 0; i < count; i++) {\n";
+    out << "            if ((int32_t)handles[i] == hid) continue;\n";
+    out << "            if (kept != i) {\n";
+    out << "                handles[kept] = handles[i];\n";
+    out << "                kinds[kept] = kinds[i];\n";
+    out << "                names[kept] = names[i];\n";
+    out << "                values[kept] = values[i];\n";
+    out << "            }\n";
+    out << "            kept++;\n";
+    out << "        }\n";
+    out << "        count = kept;\n";
+    out << "        webcc::dom::remove_element(h);\n";
+    out << "    }\n";
+    out << "    void commit() {\n";
+    out << "        for (int i = 0; i < count; i++) {\n";
+    out << "            switch (kinds[i]) {\n";
+    out << "                case Text: webcc::dom::set_inner_text(handles[i], values[i]); break;\n";
+    out << "                case Html: webcc::dom::set_inner_html(handles[i], values[i]); break;\n";
+    out << "                case Attribute: webcc::dom::set_attribute(handles[i], names[i], values[i]); break;\n";
+    out << "                case Property: webcc::dom::set_property(handles[i], names[i], values[i]); break;\n";
+    out << "            }\n";
+    out << "        }\n";
+    out << "        count = 0;\n";
+    out << "    }\n";
+    out << "    void flush() {\n";
+    out << "        commit();\n";
+    out << "        webcc::flush();\n";
+    out << "    }\n";
+    out << "};\n";
+    out << "DomWriteBuffer<> g_dom_writes;\n\n";
+
     out << "int g_view_depth = 0;\n";
 
     // Emit feature-specific globals (dispatchers, callbacks, etc.)
@@ -162,7 +439,9 @@ void generate_cpp_code(
     // Output global enums (defined outside components)
     for (const auto &enum_def : all_global_enums)
     {
+        out << shake_region_begin({qualified_name(enum_def->module_name, enum_def->name)});
         out << enum_def->to_webcc();
+        out << shake_region_end();
     }
     if (!all_global_enums.empty())
     {
@@ -174,6 +453,7 @@ void generate_cpp_code(
     {
         for (const auto &enum_def : comp.enums)
         {
+            out << shake_region_begin({qualified_name(comp.module_name, comp.name) + "_" + enum_def->name});
             out << "enum struct " << qualified_name(comp.module_name, comp.name) << "_" << enum_def->name << " : ";
             size_t total_values = enum_def->values.size() + 1;
             if (total_values <= 256) out << "uint8_t";
@@ -185,13 +465,16 @@ void generate_cpp_code(
                 out << "    " << val << ",\n";
             }
             out << "    _COUNT\n};\n";
+            out << shake_region_end();
         }
     }
 
     // Output global data types (defined outside components)
     for (const auto &data_def : all_global_data)
     {
+        out << shake_region_begin({qualified_name(data_def->module_name, data_def->name)});
         out << data_def->to_webcc();
+        out << shake_region_end();
     }
     if (!all_global_data.empty())
     {
@@ -216,31 +499,50 @@ void generate_cpp_code(
 
         for (const auto &data_def : comp.data)
         {
+            out << shake_region_begin({qualified_name(comp.module_name, comp.name) + "_" + data_def->name});
             out << "struct " << qualified_name(comp.module_name, comp.name) << "_" << data_def->name << " {\n";
             for (const auto &field : data_def->fields)
             {
                 out << "    " << convert_type(field.type) << " " << field.name << ";\n";
             }
             out << "};\n";
+            out << shake_region_end();
         }
 
         ComponentTypeContext::instance().clear();
     }
     out << "\n";
 
-    // Output field token constants for Meta.has(Type.field)
-    if (features.json)
+    // Data type names as registered for JSON codegen (component-local types are prefixed)
+    std::vector<std::string> json_type_names;
+    for (const auto &data_def : all_global_data)
+    {
+        json_type_names.push_back(qualified_name(data_def->module_name, data_def->name));
+    }
+    for (const auto &comp : all_components)
     {
-        for (const auto &data_def : all_global_data)
+        for (const auto &data_def : comp.data)
         {
-            out << generate_field_token_constants(qualified_name(data_def->module_name, data_def->name));
+            json_type_names.push_back(qualified_name(comp.module_name, comp.name) + "_" + data_def->name);
         }
-        for (const auto &comp : all_components)
+    }
+
+    // Output field token constants for Meta.has(Type.field)
+    if (features.json)
+    {
+        for (const auto &type_name : json_type_names)
         {
-            for (const auto &data_def : comp.data)
+            std::vector<std::string> symbols;
+            if (auto *fields = DataTypeRegistry::instance().lookup(type_name))
             {
-                out << generate_field_token_constants(qualified_name(comp.module_name, comp.name) + "_" + data_def->name);
+                for (const auto &field : *fields)
+                {
+                    symbols.push_back(field_token_symbol_name(type_name, field.name));
+                }
             }
+            out << shake_region_begin(symbols);
+            out << generate_field_token_constants(type_name);
+            out << shake_region_end();
         }
         out << "\n";
     }
@@ -248,17 +550,11 @@ void generate_cpp_code(
     // Output Meta structs for JSON parsing (if Json.parse is used)
     if (features.json)
     {
-        for (const auto &data_def : all_global_data)
+        for (const auto &type_name : json_type_names)
         {
-            out << generate_meta_struct(qualified_name(data_def->module_name, data_def->name));
-        }
-        for (const auto &comp : all_components)
-        {
-            for (const auto &data_def : comp.data)
-            {
-                // Use prefixed name for component-local types
-                out << generate_meta_struct(qualified_name(comp.module_name, comp.name) + "_" + data_def->name);
-            }
+            out << shake_region_begin({type_name + "Meta"});
+            out << generate_meta_struct(type_name);
+            out << shake_region_end();
         }
         out << "\n";
     }
@@ -266,7 +562,9 @@ void generate_cpp_code(
     // Forward declarations
     for (auto *comp : sorted_components)
     {
+        out << shake_region_begin({qualified_name(comp->module_name, comp->name)});
         out << "struct " << qualified_name(comp->module_name, comp->name) << ";\n";
+        out << shake_region_end();
     }
     out << "\n";
 
@@ -274,9 +572,20 @@ void generate_cpp_code(
     out << "void g_app_navigate(const coi::string& route);\n";
     out << "coi::string g_app_get_route();\n\n";
 
+    for (size_t i = 0; i < route_sheets.size(); ++i)
+    {
+        out << "webcc::handle g_route_css_" << i << ";\n";
+    }
+    if (!route_sheets.empty())
+    {
+        out << "\n";
+    }
+
     for (auto *comp : sorted_components)
     {
+        out << shake_region_begin({qualified_name(comp->module_name, comp->name)});
         out << comp->to_webcc(session);
+        out << shake_region_end();
     }
 
     if (final_app_config.root_component.empty())
@@ -324,8 +633,23 @@ void generate_cpp_code(
     out << "        }\n";
     out << "    }\n";
     out << "}\n\n";
+    if (g_trace_replay)
+    {
+        emit_feature_event_replay(out, features);
+    }
 
     out << "void update_wrapper(double time) {\n";
+    if (g_trace_record)
+    {
+        out << "    g_trace.begin_frame(time);\n";
+    }
+    if (g_trace_replay)
+    {
+        // While the trace lasts, recorded events and timestamps stand in for live ones
+        out << "    uint32_t replay_count = 0;\n";
+        out << "    bool replaying = g_replay.active();\n";
+        out << "    if (replaying) time = g_replay.begin_frame(replay_count);\n";
+    }
     out << "    static double last_time = 0;\n";
     out << "    double dt = (time - last_time) / 1000.0;\n";
     out << "    last_time = time;\n";
@@ -336,14 +660,35 @@ void generate_cpp_code(
     out << "    while (webcc::poll_event(e) && count < 64) {\n";
     out << "        events[count++] = e;\n";
     out << "    }\n";
-    out << "    dispatch_events(events, count);\n";
+    if (g_trace_replay)
+    {
+        out << "    if (replaying) replay_events(replay_count);\n";
+        out << "    else dispatch_events(events, count);\n";
+    }
+    else
+    {
+        out << "    dispatch_events(events, count);\n";
+    }
+    if (features.timers)
+    {
+        out << "    g_timers.run(time);\n";
+    }
     
     // Only call tick if the root component has a tick method
     if (session.components_with_tick.count(root_qualified))
     {
         out << "    if (app) app->tick(dt);\n";
     }
-    out << "    webcc::flush();\n";
+    out << "    g_dom_writes.flush();\n";
+    if (g_trace_record)
+    {
+        out << "    g_trace.end_frame();\n";
+    }
+    if (g_trace_replay)
+    {
+        out << "    if (replaying) g_replay.end_frame();\n";
+    }
+    out << "    g_frame.reset();\n";
     out << "}\n\n";
 
     out << "int main() {\n";
@@ -353,9 +698,22 @@ void generate_cpp_code(
     out << "    void* app_mem = coi::malloc(sizeof(" << root_qualified << "));\n";
     out << "    app = new (app_mem) " << root_qualified << "();\n";
     emit_feature_init(out, features, root_qualified);
+    for (size_t i = 0; i < route_sheets.size(); ++i)
+    {
+        std::string handle = "g_route_css_" + std::to_string(i);
+        out << "    " << handle << " = webcc::handle(webcc::next_deferred_handle());\n";
+        out << "    webcc::dom::create_element_deferred(" << handle << ", \"link\");\n";
+        out << "    webcc::dom::set_attribute(" << handle << ", \"rel\", \"stylesheet\");\n";
+        out << "    webcc::dom::set_attribute(" << handle << ", \"media\", \"not all\");\n";
+        out << "    webcc::dom::set_attribute(" << handle << ", \"href\", \"./" << route_sheets[i].file << "\");\n";
+        out << "    webcc::dom::append_child(webcc::dom::get_body(), " << handle << ");\n";
+    }
     out << "    app->view();\n";
     out << "    webcc::system::set_main_loop(update_wrapper);\n";
-    out << "    webcc::flush();\n";
+    out << "    g_dom_writes.flush();\n";
+    out << "    g_frame.reset();\n";
     out << "    return 0;\n";
     out << "}\n";
+
+    target << tree_shake(out.str());
 }
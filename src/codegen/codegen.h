@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include "trace_codegen.h"
 
 // Forward declarations
 struct Component;
@@ -12,6 +13,7 @@ struct EnumDef;
 struct AppConfig;
 struct FeatureFlags;
 struct CompilerSession;
+struct RouteStylesheet;
 
 // Generate C++ code from components
 void generate_cpp_code(
@@ -21,5 +23,8 @@ void generate_cpp_code(
     const std::vector<std::unique_ptr<EnumDef>> &all_global_enums,
     const AppConfig &final_app_config,
     const std::set<std::string> &required_headers,
-    const FeatureFlags &features);
+    const FeatureFlags &features,
+    const std::vector<RouteStylesheet> &route_sheets,
+    bool debug_build = false,
+    const TraceOptions &trace = TraceOptions());
 
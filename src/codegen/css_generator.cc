@@ -1,24 +1,541 @@
 #include "css_generator.h"
 #include "ast/ast.h"
 #include "../cli/error.h"
+#include "../analysis/dependency_resolver.h"
+#include "../ast/codegen_state.h"
+#include "css_optimizer.h"
+#include "../cli/sha256.h"
+#include <cctype>
 #include <fstream>
+#include <map>
+#include <set>
 #include <sstream>
 #include <algorithm>
 #include <iostream>
 
 namespace fs = std::filesystem;
 
+// Tags and classes a component's own view can put on elements carrying its scope attribute
+struct ViewVocabulary
+{
+    std::set<std::string> tags;
+    std::set<std::string> classes;
+    bool open_classes = false;  // A class depends on an expression, or elements escape through refs
+};
+
+static void collect_view_vocabulary(ASTNode *node, ViewVocabulary &vocab)
+{
+    if (auto *el = dynamic_cast<HTMLElement *>(node))
+    {
+        std::string tag = el->tag;
+        std::transform(tag.begin(), tag.end(), tag.begin(), ::tolower);
+        vocab.tags.insert(tag);
+        if (!el->ref_binding.empty())
+            vocab.open_classes = true;
+        for (const auto &attr : el->attributes)
+        {
+            if (attr.name != "class")
+                continue;
+            auto *lit = dynamic_cast<StringLiteral *>(attr.value.get());
+            if (!lit || !lit->is_static())
+            {
+                vocab.open_classes = true;
+                continue;
+            }
+            std::stringstream words(lit->value);
+            std::string cls;
+            while (words >> cls)
+                vocab.classes.insert(cls);
+        }
+        for (const auto &child : el->children)
+            collect_view_vocabulary(child.get(), vocab);
+    }
+    else if (auto *view_if = dynamic_cast<ViewIfStatement *>(node))
+    {
+        for (const auto &child : view_if->then_children)
+            collect_view_vocabulary(child.get(), vocab);
+        for (const auto &child : view_if->else_children)
+            collect_view_vocabulary(child.get(), vocab);
+    }
+    else if (auto *view_for = dynamic_cast<ViewForRangeStatement *>(node))
+    {
+        for (const auto &child : view_for->children)
+            collect_view_vocabulary(child.get(), vocab);
+    }
+    else if (auto *view_for_each = dynamic_cast<ViewForEachStatement *>(node))
+    {
+        for (const auto &child : view_for_each->children)
+            collect_view_vocabulary(child.get(), vocab);
+    }
+    else if (dynamic_cast<ViewRawElement *>(node))
+    {
+        // Raw HTML is wrapped in a scoped span; its inner markup carries no scope attribute
+        vocab.tags.insert("span");
+    }
+}
+
+// False when the compound selector that receives the scope attribute names a tag or class the
+// component never renders. Anything the check does not understand is assumed to match.
+static bool scoped_selector_can_match(const std::string &selector, const ViewVocabulary &vocab)
+{
+    size_t first = selector.find_first_not_of(" \t\n\r");
+    size_t last = selector.find_last_not_of(" \t\n\r");
+    if (first == std::string::npos)
+        return true;
+    std::string trimmed = selector.substr(first, last - first + 1);
+    size_t colon = trimmed.find(':');
+    std::string anchor = colon == std::string::npos ? trimmed : trimmed.substr(0, colon);
+    size_t start = anchor.find_last_of(" \t\n\r>+~");
+    std::string compound = start == std::string::npos ? anchor : anchor.substr(start + 1);
+    if (compound.empty() || compound.find_first_of("\\[(") != std::string::npos)
+        return true;
+
+    auto is_ident = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_'; };
+    size_t pos = 0;
+    while (pos < compound.size() && is_ident(compound[pos]))
+        pos++;
+    if (pos > 0)
+    {
+        std::string tag = compound.substr(0, pos);
+        std::transform(tag.begin(), tag.end(), tag.begin(), ::tolower);
+        if (!vocab.tags.count(tag))
+            return false;
+    }
+    while (pos < compound.size())
+    {
+        char kind = compound[pos++];
+        size_t name_start = pos;
+        while (pos < compound.size() && is_ident(compound[pos]))
+            pos++;
+        if (kind == '.' && !vocab.open_classes && !vocab.classes.count(compound.substr(name_start, pos - name_start)))
+            return false;
+    }
+    return true;
+}
+
+// Write one component's global and/or scoped styles. With a vocabulary, scoped rules that
+// cannot match anything the component renders are left out.
+static void write_component_css(std::ostream &css_out, const Component &comp,
+                                bool include_global = true, bool include_scoped = true,
+                                const ViewVocabulary *vocab = nullptr)
+{
+    bool has_global = include_global && !comp.global_css.empty();
+    bool has_scoped = include_scoped && !comp.css.empty();
+    if (has_global || has_scoped)
+    {
+        css_out << "/* " << comp.name << " */\n";
+    }
+
+    // Global CSS (no scoping)
+    if (has_global)
+    {
+        css_out << comp.global_css << "\n";
+    }
+
+    // Scoped CSS: prefix selectors with [coi-scope="ComponentName"]
+    // Handle @keyframes and @media specially
+    if (has_scoped)
+    {
+        std::string raw = comp.css;
+        std::string qname = qualified_name(comp.module_name, comp.name);
+        std::string scope_name = css_scope_name(qname);
+        // Short release scopes (a, b, ...) are plain identifiers and need no quotes
+        std::string scope_attr = g_css_scope_names.count(qname) ? "[coi-scope=" + scope_name + "]"
+                                                                : "[coi-scope=\"" + scope_name + "\"]";
+        size_t pos = 0;
+
+        // Helper lambda to scope a single selector
+        auto scope_selector = [&](const std::string &sel) -> std::string
+        {
+            size_t start = sel.find_first_not_of(" \t\n\r");
+            size_t end = sel.find_last_not_of(" \t\n\r");
+            if (start == std::string::npos)
+                return sel;
+            std::string trimmed = sel.substr(start, end - start + 1);
+            size_t colon = trimmed.find(':');
+            if (colon != std::string::npos)
+            {
+                return trimmed.substr(0, colon) + scope_attr + trimmed.substr(colon);
+            }
+            else
+            {
+                return trimmed + scope_attr;
+            }
+        };
+
+        // Scope each selector of a comma-separated group; empty when every selector was pruned
+        auto scope_group = [&](const std::string &group) -> std::string
+        {
+            std::stringstream ss_sel(group);
+            std::string selector;
+            std::string scoped;
+            bool first = true;
+            while (std::getline(ss_sel, selector, ','))
+            {
+                if (vocab && !scoped_selector_can_match(selector, *vocab))
+                    continue;
+                if (!first)
+                    scoped += ",";
+                scoped += scope_selector(selector);
+                first = false;
+            }
+            return scoped;
+        };
+
+        while (pos < raw.length())
+        {
+            // Skip whitespace
+            while (pos < raw.length() && std::isspace(raw[pos]))
+            {
+                css_out << raw[pos];
+                pos++;
+            }
+            if (pos >= raw.length())
+                break;
+
+            // Check for @keyframes
+            if (raw.substr(pos, 10) == "@keyframes")
+            {
+                size_t kf_start = pos;
+                size_t kf_brace = raw.find('{', pos);
+                if (kf_brace == std::string::npos)
+                {
+                    css_out << raw.substr(pos);
+                    break;
+                }
+                // Output @keyframes name as-is (no scoping)
+                css_out << raw.substr(pos, kf_brace - pos + 1);
+                pos = kf_brace + 1;
+
+                // Find matching closing brace for @keyframes block
+                int brace_depth = 1;
+                size_t kf_end = pos;
+                while (kf_end < raw.length() && brace_depth > 0)
+                {
+                    if (raw[kf_end] == '{')
+                        brace_depth++;
+                    else if (raw[kf_end] == '}')
+                        brace_depth--;
+                    kf_end++;
+                }
+                // Output keyframes content as-is (from, to, percentages don't get scoped)
+                css_out << raw.substr(pos, kf_end - pos);
+                pos = kf_end;
+                continue;
+            }
+
+            // Check for @media
+            if (raw.substr(pos, 6) == "@media")
+            {
+                size_t media_brace = raw.find('{', pos);
+                if (media_brace == std::string::npos)
+                {
+                    css_out << raw.substr(pos);
+                    break;
+                }
+                // Output @media query as-is
+                css_out << raw.substr(pos, media_brace - pos + 1) << "\n";
+                pos = media_brace + 1;
+
+                // Find matching closing brace for @media block
+                int brace_depth = 1;
+                size_t media_end = pos;
+                while (media_end < raw.length() && brace_depth > 0)
+                {
+                    if (raw[media_end] == '{')
+                        brace_depth++;
+                    else if (raw[media_end] == '}')
+                        brace_depth--;
+                    media_end++;
+                }
+                media_end--; // Back up to the closing brace
+
+                // Process selectors inside @media
+                while (pos < media_end)
+                {
+                    size_t brace = raw.find('{', pos);
+                    if (brace == std::string::npos || brace >= media_end)
+                        break;
+
+                    std::string scoped = scope_group(raw.substr(pos, brace - pos));
+                    size_t end_brace = raw.find('}', brace);
+                    if (vocab && scoped.empty() && end_brace != std::string::npos && end_brace < media_end)
+                    {
+                        pos = end_brace + 1;
+                        continue;
+                    }
+                    css_out << scoped;
+
+                    if (end_brace == std::string::npos || end_brace >= media_end)
+                    {
+                        css_out << raw.substr(brace, media_end - brace);
+                        break;
+                    }
+                    css_out << raw.substr(brace, end_brace - brace + 1) << "\n";
+                    pos = end_brace + 1;
+                }
+                css_out << "}\n";
+                pos = media_end + 1;
+                continue;
+            }
+
+            // Regular selector
+            size_t brace = raw.find('{', pos);
+            if (brace == std::string::npos)
+            {
+                css_out << raw.substr(pos);
+                break;
+            }
+
+            std::string scoped = scope_group(raw.substr(pos, brace - pos));
+            size_t end_brace = raw.find('}', brace);
+            if (vocab && scoped.empty() && end_brace != std::string::npos)
+            {
+                pos = end_brace + 1;
+                continue;
+            }
+            css_out << scoped;
+
+            if (end_brace == std::string::npos)
+            {
+                css_out << raw.substr(brace);
+                break;
+            }
+            css_out << raw.substr(brace, end_brace - brace + 1) << "\n";
+            pos = end_brace + 1;
+        }
+        css_out << "\n";
+    }
+}
+
+// Component types a component instantiates: view children plus component-typed params and state.
+// Router targets are deliberately left out; they are entry points of their own.
+static std::set<std::string> child_components(const Component &comp, const std::set<std::string> &known)
+{
+    std::set<std::string> children;
+    for (const auto &root : comp.render_roots)
+    {
+        collect_component_deps(root.get(), children);
+    }
+
+    auto add_type = [&](std::string type)
+    {
+        size_t bracket = type.find('[');
+        if (bracket != std::string::npos)
+            type = type.substr(0, bracket);
+        size_t dcolon = type.find("::");
+        if (dcolon != std::string::npos)
+            type = type.substr(0, dcolon) + "_" + type.substr(dcolon + 2);
+        if (known.count(type))
+            children.insert(type);
+        else if (known.count(qualified_name(comp.module_name, type)))
+            children.insert(qualified_name(comp.module_name, type));
+    };
+    for (const auto &param : comp.params)
+        add_type(param->type);
+    for (const auto &var : comp.state)
+        add_type(var->type);
+    return children;
+}
+
+// Vocabulary of every component's own view, for pruning scoped rules in release builds
+static std::map<const Component *, ViewVocabulary> view_vocabularies(const std::vector<Component> &all_components)
+{
+    std::map<const Component *, ViewVocabulary> vocabularies;
+    for (const auto &comp : all_components)
+    {
+        ViewVocabulary &vocab = vocabularies[&comp];
+        for (const auto &root : comp.render_roots)
+            collect_view_vocabulary(root.get(), vocab);
+    }
+    return vocabularies;
+}
+
+std::vector<RouteStylesheet> plan_route_stylesheets(
+    const std::vector<Component> &all_components,
+    const std::string &root_component,
+    bool release)
+{
+    std::map<std::string, const Component *> by_name;
+    std::set<std::string> known;
+    const Component *root = nullptr;
+    for (const auto &comp : all_components)
+    {
+        std::string qname = qualified_name(comp.module_name, comp.name);
+        by_name[qname] = &comp;
+        known.insert(qname);
+        if (!root && comp.name == root_component)
+            root = &comp;
+    }
+    if (!root)
+        return {};
+
+    std::map<std::string, std::set<std::string>> children;
+    std::vector<std::string> entries = {qualified_name(root->module_name, root->name)};
+    std::set<std::string> route_targets;
+    for (const auto &comp : all_components)
+    {
+        children[qualified_name(comp.module_name, comp.name)] = child_components(comp, known);
+        if (!comp.router)
+            continue;
+        for (const auto &route : comp.router->routes)
+        {
+            std::string target = qualified_name(route.module_name, route.component_name);
+            if (known.count(target) && route_targets.insert(target).second)
+                entries.push_back(target);
+        }
+    }
+    if (route_targets.empty())
+        return {};
+
+    // Which entries reach each component without crossing a router
+    std::map<std::string, std::set<std::string>> reached_by;
+    for (const auto &entry : entries)
+    {
+        std::vector<std::string> stack = {entry};
+        std::set<std::string> seen = {entry};
+        while (!stack.empty())
+        {
+            std::string name = stack.back();
+            stack.pop_back();
+            reached_by[name].insert(entry);
+            for (const auto &child : children[name])
+            {
+                if (seen.insert(child).second)
+                    stack.push_back(child);
+            }
+        }
+    }
+
+    // A component's scoped CSS moves to a route sheet only when that route is the sole entry
+    // reaching it; anything shared, reachable from the root, or unreached stays in app.css
+    std::vector<RouteStylesheet> sheets;
+    for (size_t i = 1; i < entries.size(); ++i)
+    {
+        RouteStylesheet sheet;
+        sheet.route_component = entries[i];
+        sheet.file = "route-" + entries[i] + ".css";
+        for (const auto &comp : all_components)
+        {
+            const auto &owners = reached_by[qualified_name(comp.module_name, comp.name)];
+            if (!comp.css.empty() && owners.size() == 1 && *owners.begin() == entries[i])
+                sheet.components.push_back(&comp);
+        }
+        if (!sheet.components.empty())
+            sheets.push_back(std::move(sheet));
+    }
+
+    // Release sheets are named by content, like app.css, so they can be cached as immutable
+    std::map<const Component *, ViewVocabulary> vocabularies;
+    if (release)
+        vocabularies = view_vocabularies(all_components);
+    for (auto &sheet : sheets)
+    {
+        std::stringstream sheet_out;
+        for (const auto *comp : sheet.components)
+        {
+            auto vocab = vocabularies.find(comp);
+            write_component_css(sheet_out, *comp, false, true, vocab == vocabularies.end() ? nullptr : &vocab->second);
+        }
+        sheet.css = release ? optimize_css(sheet_out.str()) : sheet_out.str();
+        if (release)
+            sheet.file = "route-" + sheet.route_component + "." + sha256_hex(sheet.css).substr(0, 10) + ".css";
+    }
+    return sheets;
+}
+
+// Components reachable from the root through views, component-typed members and routers;
+// empty when the root is unknown
+static std::set<std::string> rendered_components(const std::vector<Component> &all_components,
+                                                 const std::string &root_component)
+{
+    std::map<std::string, const Component *> by_name;
+    std::set<std::string> known;
+    std::string root;
+    for (const auto &comp : all_components)
+    {
+        std::string qname = qualified_name(comp.module_name, comp.name);
+        by_name[qname] = &comp;
+        known.insert(qname);
+        if (root.empty() && comp.name == root_component)
+            root = qname;
+    }
+
+    std::set<std::string> rendered;
+    if (root.empty())
+        return rendered;
+    std::vector<std::string> stack = {root};
+    rendered.insert(root);
+    while (!stack.empty())
+    {
+        const Component &comp = *by_name[stack.back()];
+        stack.pop_back();
+        std::set<std::string> next = child_components(comp, known);
+        if (comp.router)
+        {
+            for (const auto &route : comp.router->routes)
+                next.insert(qualified_name(route.module_name, route.component_name));
+        }
+        for (const auto &name : next)
+        {
+            if (by_name.count(name) && rendered.insert(name).second)
+                stack.push_back(name);
+        }
+    }
+    return rendered;
+}
+
+void assign_short_css_scopes(const std::vector<Component> &all_components)
+{
+    g_css_scope_names.clear();
+    size_t next = 0;
+    for (const auto &comp : all_components)
+    {
+        if (comp.css.empty())
+            continue;
+        // Bijective base-26: a..z, aa..zz, ... always a valid unquoted CSS identifier
+        std::string name;
+        for (size_t n = next++ + 1; n > 0; n = (n - 1) / 26)
+            name.insert(name.begin(), static_cast<char>('a' + (n - 1) % 26));
+        g_css_scope_names[qualified_name(comp.module_name, comp.name)] = name;
+    }
+}
+
+static bool write_css(const fs::path &path, const std::string &css, bool release)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    out << (release ? optimize_css(css) : css);
+    return static_cast<bool>(out);
+}
+
 void generate_css_file(
     const fs::path &css_path,
     const fs::path &input_file,
-    const std::vector<Component> &all_components)
+    const std::vector<Component> &all_components,
+    const std::vector<RouteStylesheet> &route_sheets,
+    bool release,
+    const std::string &root_component,
+    bool kept_branches)
 {
-    std::ofstream css_out(css_path);
-    if (!css_out)
+    std::stringstream css_out;
+
+    // Route sheets from a previous build may belong to routes that no longer exist
+    fs::path out_dir = css_path.parent_path();
+    std::error_code ec;
+    for (const auto &entry : fs::directory_iterator(out_dir.empty() ? fs::path(".") : out_dir, ec))
     {
-        return;
+        std::string name = entry.path().filename().string();
+        if (name.rfind("route-", 0) == 0 && entry.path().extension() == ".css")
+            fs::remove(entry.path(), ec);
     }
 
+    // <if keep> hides a branch with the hidden property, which an author `display` rule on
+    // the branch's element would otherwise override
+    if (kept_branches)
+        css_out << "[hidden] { display: none !important; }\n";
+
     // Bundle external stylesheets from styles/ folder at project root
     // Project root is the parent of src/
     fs::path input_dir = fs::path(input_file).parent_path();
@@ -60,181 +577,50 @@ void generate_css_file(
         }
     }
 
-    // Collect all CSS from components
-    for (const auto &comp : all_components)
+    // Release builds drop scoped styles of components that are never rendered, and scoped
+    // rules that cannot match the elements a component renders
+    std::set<std::string> rendered;
+    std::map<const Component *, ViewVocabulary> vocabularies;
+    if (release)
     {
-        bool has_styles = !comp.global_css.empty() || !comp.css.empty();
-        if (has_styles)
-        {
-            css_out << "/* " << comp.name << " */\n";
-        }
+        rendered = rendered_components(all_components, root_component);
+        vocabularies = view_vocabularies(all_components);
+    }
+    auto keep_scoped = [&](const Component &comp)
+    {
+        return rendered.empty() || rendered.count(qualified_name(comp.module_name, comp.name));
+    };
+    auto vocabulary = [&](const Component &comp) -> const ViewVocabulary *
+    {
+        auto it = vocabularies.find(&comp);
+        return it == vocabularies.end() ? nullptr : &it->second;
+    };
 
-        // Global CSS (no scoping)
-        if (!comp.global_css.empty())
-        {
-            css_out << comp.global_css << "\n";
-        }
+    // Collect all CSS from components; scoped styles of route-only components go to their route sheet
+    std::set<const Component *> deferred;
+    for (const auto &sheet : route_sheets)
+    {
+        deferred.insert(sheet.components.begin(), sheet.components.end());
+    }
+    for (const auto &comp : all_components)
+    {
+        write_component_css(css_out, comp, true, !deferred.count(&comp) && keep_scoped(comp), vocabulary(comp));
+    }
+    if (!write_css(css_path, css_out.str(), release))
+    {
+        return;
+    }
+    std::cerr << "Generated " << css_path.string() << std::endl;
 
-        // Scoped CSS: prefix selectors with [coi-scope="ComponentName"]
-        // Handle @keyframes and @media specially
-        if (!comp.css.empty())
+    for (const auto &sheet : route_sheets)
+    {
+        // Contents were rendered (and optimized) by plan_route_stylesheets
+        fs::path sheet_path = out_dir / sheet.file;
+        if (!write_css(sheet_path, sheet.css, false))
         {
-            std::string raw = comp.css;
-            std::string scope_name = qualified_name(comp.module_name, comp.name);
-            size_t pos = 0;
-
-            // Helper lambda to scope a single selector
-            auto scope_selector = [&](const std::string &sel) -> std::string
-            {
-                size_t start = sel.find_first_not_of(" \t\n\r");
-                size_t end = sel.find_last_not_of(" \t\n\r");
-                if (start == std::string::npos)
-                    return sel;
-                std::string trimmed = sel.substr(start, end - start + 1);
-                size_t colon = trimmed.find(':');
-                if (colon != std::string::npos)
-                {
-                    return trimmed.substr(0, colon) + "[coi-scope=\"" + scope_name + "\"]" + trimmed.substr(colon);
-                }
-                else
-                {
-                    return trimmed + "[coi-scope=\"" + scope_name + "\"]";
-                }
-            };
-
-            while (pos < raw.length())
-            {
-                // Skip whitespace
-                while (pos < raw.length() && std::isspace(raw[pos]))
-                {
-                    css_out << raw[pos];
-                    pos++;
-                }
-                if (pos >= raw.length())
-                    break;
-
-                // Check for @keyframes
-                if (raw.substr(pos, 10) == "@keyframes")
-                {
-                    size_t kf_start = pos;
-                    size_t kf_brace = raw.find('{', pos);
-                    if (kf_brace == std::string::npos)
-                    {
-                        css_out << raw.substr(pos);
-                        break;
-                    }
-                    // Output @keyframes name as-is (no scoping)
-                    css_out << raw.substr(pos, kf_brace - pos + 1);
-                    pos = kf_brace + 1;
-
-                    // Find matching closing brace for @keyframes block
-                    int brace_depth = 1;
-                    size_t kf_end = pos;
-                    while (kf_end < raw.length() && brace_depth > 0)
-                    {
-                        if (raw[kf_end] == '{')
-                            brace_depth++;
-                        else if (raw[kf_end] == '}')
-                            brace_depth--;
-                        kf_end++;
-                    }
-                    // Output keyframes content as-is (from, to, percentages don't get scoped)
-                    css_out << raw.substr(pos, kf_end - pos);
-                    pos = kf_end;
-                    continue;
-                }
-
-                // Check for @media
-                if (raw.substr(pos, 6) == "@media")
-                {
-                    size_t media_brace = raw.find('{', pos);
-                    if (media_brace == std::string::npos)
-                    {
-                        css_out << raw.substr(pos);
-                        break;
-                    }
-                    // Output @media query as-is
-                    css_out << raw.substr(pos, media_brace - pos + 1) << "\n";
-                    pos = media_brace + 1;
-
-                    // Find matching closing brace for @media block
-                    int brace_depth = 1;
-                    size_t media_end = pos;
-                    while (media_end < raw.length() && brace_depth > 0)
-                    {
-                        if (raw[media_end] == '{')
-                            brace_depth++;
-                        else if (raw[media_end] == '}')
-                            brace_depth--;
-                        media_end++;
-                    }
-                    media_end--; // Back up to the closing brace
-
-                    // Process selectors inside @media
-                    while (pos < media_end)
-                    {
-                        size_t brace = raw.find('{', pos);
-                        if (brace == std::string::npos || brace >= media_end)
-                            break;
-
-                        std::string selector_group = raw.substr(pos, brace - pos);
-                        std::stringstream ss_sel(selector_group);
-                        std::string selector;
-                        bool first = true;
-                        while (std::getline(ss_sel, selector, ','))
-                        {
-                            if (!first)
-                                css_out << ",";
-                            css_out << scope_selector(selector);
-                            first = false;
-                        }
-
-                        size_t end_brace = raw.find('}', brace);
-                        if (end_brace == std::string::npos || end_brace >= media_end)
-                        {
-                            css_out << raw.substr(brace, media_end - brace);
-                            break;
-                        }
-                        css_out << raw.substr(brace, end_brace - brace + 1) << "\n";
-                        pos = end_brace + 1;
-                    }
-                    css_out << "}\n";
-                    pos = media_end + 1;
-                    continue;
-                }
-
-                // Regular selector
-                size_t brace = raw.find('{', pos);
-                if (brace == std::string::npos)
-                {
-                    css_out << raw.substr(pos);
-                    break;
-                }
-
-                std::string selector_group = raw.substr(pos, brace - pos);
-                std::stringstream ss_sel(selector_group);
-                std::string selector;
-                bool first = true;
-                while (std::getline(ss_sel, selector, ','))
-                {
-                    if (!first)
-                        css_out << ",";
-                    css_out << scope_selector(selector);
-                    first = false;
-                }
-
-                size_t end_brace = raw.find('}', brace);
-                if (end_brace == std::string::npos)
-                {
-                    css_out << raw.substr(brace);
-                    break;
-                }
-                css_out << raw.substr(brace, end_brace - brace + 1) << "\n";
-                pos = end_brace + 1;
-            }
-            css_out << "\n";
+            ErrorHandler::warning("Could not write route stylesheet: " + sheet_path.string());
+            continue;
         }
+        std::cerr << "Generated " << sheet_path.string() << std::endl;
     }
-    css_out.close();
-    std::cerr << "Generated " << css_path.string() << std::endl;
 }
@@ -7,8 +7,39 @@
 // Forward declarations
 struct Component;
 
-// Generate CSS file with component styles and external stylesheets
+// Stylesheet applied the first time a route target activates
+struct RouteStylesheet
+{
+    std::string route_component;               // Qualified name of the route target
+    std::string file;                          // e.g. "route-Dashboard.css" next to app.css; release builds
+                                               // add a content hash ("route-Dashboard.3f9c2d41ab.css")
+    std::vector<const Component *> components; // Components whose scoped CSS it holds
+    std::string css;                           // Final contents (pruned and optimized in release builds)
+};
+
+// Split scoped CSS by route: entries are the root component and every router target, and a
+// component belongs to a route sheet only if that route is the one entry reaching it through
+// view children. Returns no sheets for apps without a router. Release builds need the short
+// scope names assigned first, since the sheet contents (and so their file names) depend on them.
+std::vector<RouteStylesheet> plan_route_stylesheets(
+    const std::vector<Component> &all_components,
+    const std::string &root_component,
+    bool release = false);
+
+// Generate CSS file with component styles and external stylesheets,
+// plus one file per route sheet next to it.
+// Release builds also prune scoped rules that cannot match any rendered element (needs
+// root_component) and run every file through optimize_css. kept_branches adds the rule that
+// keeps hidden <if keep> branches hidden.
 void generate_css_file(
     const std::filesystem::path &css_path,
     const std::filesystem::path &input_file,
-    const std::vector<Component> &all_components);
+    const std::vector<Component> &all_components,
+    const std::vector<RouteStylesheet> &route_sheets = {},
+    bool release = false,
+    const std::string &root_component = "",
+    bool kept_branches = false);
+
+// Give every component with scoped styles a short scope attribute value (a, b, ..., aa, ...),
+// used by both the generated DOM code and the CSS. Call before code generation.
+void assign_short_css_scopes(const std::vector<Component> &all_components);
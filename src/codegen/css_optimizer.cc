@@ -0,0 +1,452 @@
+#include "css_optimizer.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <regex>
+#include <set>
+#include <vector>
+
+struct CssNode
+{
+    enum Kind
+    {
+        Rule,        // selector { declarations }
+        AtBlock,     // @media ... { rules } or @font-face { declarations }
+        AtStatement  // @import ...;
+    };
+    Kind kind = Rule;
+    std::string prelude;
+    std::string body;              // Declarations (Rule, and AtBlock without nested rules)
+    std::vector<CssNode> children; // Nested rules (AtBlock with nested rules)
+    bool nested_rules = false;
+    bool merge_children = false;   // Children may be merged (not inside @keyframes)
+    bool dropped = false;
+};
+
+static bool is_space(char c)
+{
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+// Index just past the string literal starting at pos
+static size_t skip_string(const std::string &css, size_t pos, size_t end)
+{
+    char quote = css[pos++];
+    while (pos < end && css[pos] != quote)
+    {
+        if (css[pos] == '\\')
+            pos++;
+        pos++;
+    }
+    return std::min(pos + 1, end);
+}
+
+// Index just past the comment starting at pos
+static size_t skip_comment(const std::string &css, size_t pos, size_t end)
+{
+    size_t close = css.find("*/", pos + 2);
+    return close == std::string::npos || close + 2 > end ? end : close + 2;
+}
+
+static bool starts_comment(const std::string &css, size_t pos, size_t end)
+{
+    return css[pos] == '/' && pos + 1 < end && css[pos + 1] == '*';
+}
+
+// Index of the first top-level '{', ';' or '}' at or after pos (end when there is none)
+static size_t find_prelude_end(const std::string &css, size_t pos, size_t end)
+{
+    int parens = 0;
+    while (pos < end)
+    {
+        char c = css[pos];
+        if (c == '"' || c == '\'')
+        {
+            pos = skip_string(css, pos, end);
+            continue;
+        }
+        if (starts_comment(css, pos, end))
+        {
+            pos = skip_comment(css, pos, end);
+            continue;
+        }
+        if (c == '(')
+            parens++;
+        else if (c == ')' && parens > 0)
+            parens--;
+        else if (parens == 0 && (c == '{' || c == ';' || c == '}'))
+            return pos;
+        pos++;
+    }
+    return end;
+}
+
+// Index of the '}' matching the '{' at open (end when unbalanced)
+static size_t find_block_end(const std::string &css, size_t open, size_t end)
+{
+    int depth = 0;
+    size_t pos = open;
+    while (pos < end)
+    {
+        char c = css[pos];
+        if (c == '"' || c == '\'')
+        {
+            pos = skip_string(css, pos, end);
+            continue;
+        }
+        if (starts_comment(css, pos, end))
+        {
+            pos = skip_comment(css, pos, end);
+            continue;
+        }
+        if (c == '{')
+            depth++;
+        else if (c == '}' && --depth == 0)
+            return pos;
+        pos++;
+    }
+    return end;
+}
+
+// Drop comments and collapse whitespace. Whitespace next to a "tight" character is dropped;
+// selectors and at-rule preludes treat combinators as tight, declarations treat ':' as tight.
+static std::string minify(const std::string &text, bool declarations)
+{
+    const char *tight = declarations ? "{};,:" : "{};,>+~";
+    auto is_tight = [&](char c) { return std::strchr(tight, c) != nullptr; };
+
+    std::string out;
+    bool pending_space = false;
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        char c = text[pos];
+        if (starts_comment(text, pos, text.size()))
+        {
+            pos = skip_comment(text, pos, text.size());
+            pending_space = true;
+            continue;
+        }
+        if (is_space(c))
+        {
+            pending_space = true;
+            pos++;
+            continue;
+        }
+        if (pending_space && !out.empty() && !is_tight(out.back()) && !is_tight(c))
+            out += ' ';
+        pending_space = false;
+        if (c == '"' || c == '\'')
+        {
+            size_t next = skip_string(text, pos, text.size());
+            out.append(text, pos, next - pos);
+            pos = next;
+            continue;
+        }
+        out += c;
+        pos++;
+    }
+    return out;
+}
+
+static std::string minify_selector(const std::string &text)
+{
+    static const std::regex quoted_ident(R"(=(["'])([A-Za-z_][A-Za-z0-9_-]*)\1\])");
+    return std::regex_replace(minify(text, false), quoted_ident, "=$2]");
+}
+
+static std::string minify_declarations(const std::string &text)
+{
+    // Native nesting puts selectors in the block; keep their ':' spacing intact
+    std::string out = minify(text, text.find('{') == std::string::npos);
+    while (!out.empty() && out.back() == ';')
+        out.pop_back();
+    return out;
+}
+
+static std::string at_keyword(const std::string &prelude)
+{
+    size_t end = 1;
+    while (end < prelude.size() && (std::isalnum(static_cast<unsigned char>(prelude[end])) || prelude[end] == '-'))
+        end++;
+    std::string keyword = prelude.substr(1, end - 1);
+    std::transform(keyword.begin(), keyword.end(), keyword.begin(), ::tolower);
+    // Vendor prefixes: -webkit-keyframes -> keyframes
+    if (keyword.size() > 1 && keyword[0] == '-')
+    {
+        size_t dash = keyword.find('-', 1);
+        if (dash != std::string::npos)
+            keyword = keyword.substr(dash + 1);
+    }
+    return keyword;
+}
+
+static void parse_nodes(const std::string &css, size_t pos, size_t end, std::vector<CssNode> &out)
+{
+    static const std::set<std::string> grouping = {
+        "media", "supports", "layer", "container", "document", "scope", "starting-style", "keyframes"};
+
+    while (pos < end)
+    {
+        if (is_space(css[pos]))
+        {
+            pos++;
+            continue;
+        }
+        if (starts_comment(css, pos, end))
+        {
+            pos = skip_comment(css, pos, end);
+            continue;
+        }
+        if (css[pos] == '}')
+        {
+            // Stray closing brace; browsers ignore it too
+            pos++;
+            continue;
+        }
+
+        size_t stop = find_prelude_end(css, pos, end);
+        std::string prelude = minify_selector(css.substr(pos, stop - pos));
+        if (stop >= end || css[stop] != '{')
+        {
+            if (!prelude.empty())
+            {
+                CssNode node;
+                node.kind = CssNode::AtStatement;
+                node.prelude = prelude;
+                out.push_back(std::move(node));
+            }
+            pos = stop + 1;
+            continue;
+        }
+
+        size_t close = find_block_end(css, stop, end);
+        std::string inner = css.substr(stop + 1, close - stop - 1);
+        pos = close + 1;
+
+        CssNode node;
+        node.prelude = prelude;
+        if (!prelude.empty() && prelude[0] == '@')
+        {
+            node.kind = CssNode::AtBlock;
+            std::string keyword = at_keyword(prelude);
+            if (grouping.count(keyword))
+            {
+                node.nested_rules = true;
+                node.merge_children = keyword != "keyframes";
+                parse_nodes(inner, 0, inner.size(), node.children);
+            }
+            else
+            {
+                node.body = minify_declarations(inner);
+            }
+        }
+        else
+        {
+            node.body = minify_declarations(inner);
+        }
+        out.push_back(std::move(node));
+    }
+}
+
+// Split on top-level separators (outside strings and parentheses)
+static std::vector<std::string> split_top_level(const std::string &text, char separator)
+{
+    std::vector<std::string> parts;
+    std::string current;
+    int parens = 0;
+    for (size_t pos = 0; pos < text.size(); ++pos)
+    {
+        char c = text[pos];
+        if (c == '"' || c == '\'')
+        {
+            size_t next = skip_string(text, pos, text.size());
+            current.append(text, pos, next - pos);
+            pos = next - 1;
+            continue;
+        }
+        if (c == '(' || c == '[')
+            parens++;
+        else if ((c == ')' || c == ']') && parens > 0)
+            parens--;
+        if (c == separator && parens == 0)
+        {
+            parts.push_back(current);
+            current.clear();
+            continue;
+        }
+        current += c;
+    }
+    if (!current.empty())
+        parts.push_back(current);
+    return parts;
+}
+
+// Property families a declaration block writes. Longhands share their shorthand's family
+// (margin-top -> margin); the alias table covers shorthands whose longhands are named differently.
+static std::set<std::string> property_families(const std::string &body)
+{
+    std::set<std::string> families;
+    if (body.find('{') != std::string::npos)
+    {
+        families.insert("*");
+        return families;
+    }
+    for (const auto &declaration : split_top_level(body, ';'))
+    {
+        size_t colon = declaration.find(':');
+        if (colon == std::string::npos)
+            continue;
+        std::string name = declaration.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        if (name.rfind("--", 0) == 0)
+        {
+            families.insert(name);
+            continue;
+        }
+        if (!name.empty() && name[0] == '-')
+        {
+            size_t dash = name.find('-', 1);
+            name = dash == std::string::npos ? name : name.substr(dash + 1);
+        }
+        std::string family = name.substr(0, name.find('-'));
+
+        if (family == "all")
+            families.insert("*");
+        else if (family == "top" || family == "right" || family == "bottom" || family == "left")
+            families.insert("inset");
+        else if (family == "line")
+            families.insert("font");
+        else if (family == "align" || family == "justify")
+            families.insert("place");
+        else if (family == "row")
+            families.insert("gap");
+        else if (family == "column")
+            families.insert({"columns", "gap"});
+        else if (family == "inline" || family == "block")
+            families.insert({"width", "height"});
+        else if (family == "word")
+            families.insert("overflow");
+        else if (family == "white")
+            families.insert({"white", "text"});
+        families.insert(family);
+    }
+    return families;
+}
+
+static bool families_overlap(const std::set<std::string> &a, const std::set<std::string> &b)
+{
+    if (a.count("*") || b.count("*"))
+        return true;
+    for (const auto &family : a)
+    {
+        if (b.count(family))
+            return true;
+    }
+    return false;
+}
+
+// A selector list is dropped whole when any selector is unsupported, so vendor-specific
+// selectors are never merged into another rule
+static bool mergeable_selector(const std::string &selector)
+{
+    return selector.find(":-") == std::string::npos;
+}
+
+static void merge_rules(std::vector<CssNode> &nodes)
+{
+    std::vector<std::set<std::string>> families(nodes.size());
+    for (size_t j = 0; j < nodes.size(); ++j)
+    {
+        CssNode &rule = nodes[j];
+        if (rule.kind != CssNode::Rule)
+            continue;
+        if (rule.body.empty())
+        {
+            rule.dropped = true;
+            continue;
+        }
+        families[j] = property_families(rule.body);
+        if (!mergeable_selector(rule.prelude))
+            continue;
+
+        for (size_t i = j; i-- > 0;)
+        {
+            CssNode &earlier = nodes[i];
+            if (earlier.dropped)
+                continue;
+            if (earlier.kind != CssNode::Rule)
+                break;
+            if (earlier.body == rule.body && mergeable_selector(earlier.prelude))
+            {
+                std::vector<std::string> selectors = split_top_level(earlier.prelude, ',');
+                for (const auto &selector : split_top_level(rule.prelude, ','))
+                {
+                    if (std::find(selectors.begin(), selectors.end(), selector) == selectors.end())
+                    {
+                        earlier.prelude += "," + selector;
+                        selectors.push_back(selector);
+                    }
+                }
+                rule.dropped = true;
+                break;
+            }
+            if (families_overlap(families[i], families[j]))
+                break;
+        }
+    }
+}
+
+static void optimize_nodes(std::vector<CssNode> &nodes, bool merge)
+{
+    for (auto &node : nodes)
+    {
+        if (node.kind == CssNode::AtBlock && node.nested_rules)
+            optimize_nodes(node.children, node.merge_children);
+    }
+    if (merge)
+        merge_rules(nodes);
+}
+
+static void serialize(const std::vector<CssNode> &nodes, std::string &out)
+{
+    for (const auto &node : nodes)
+    {
+        if (node.dropped)
+            continue;
+        switch (node.kind)
+        {
+        case CssNode::AtStatement:
+            out += node.prelude + ";";
+            break;
+        case CssNode::Rule:
+            if (!node.body.empty())
+                out += node.prelude + "{" + node.body + "}";
+            break;
+        case CssNode::AtBlock:
+            if (node.nested_rules)
+            {
+                std::string inner;
+                serialize(node.children, inner);
+                if (!inner.empty())
+                    out += node.prelude + "{" + inner + "}";
+            }
+            else if (!node.body.empty())
+            {
+                out += node.prelude + "{" + node.body + "}";
+            }
+            break;
+        }
+    }
+}
+
+std::string optimize_css(const std::string &css)
+{
+    std::vector<CssNode> nodes;
+    parse_nodes(css, 0, css.size(), nodes);
+    optimize_nodes(nodes, true);
+
+    std::string out;
+    serialize(nodes, out);
+    return out;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+// Release-build CSS pass:
+// - strips comments and whitespace that carries no meaning
+// - drops empty rules and empty grouping at-rules
+// - merges a rule into an earlier rule with an identical declaration block, when no rule in
+//   between sets a property from the same family (so the cascade is unchanged)
+// - unquotes attribute selector values that are plain identifiers
+// Input it cannot parse is passed through minified but otherwise untouched.
+std::string optimize_css(const std::string &css);
@@ -0,0 +1,531 @@
+#include "heap_codegen.h"
+
+bool is_heap_allocator(const std::string& name) {
+    return name == "slab" || name == "tlsf" || name == "bump";
+}
+
+// ============================================================================
+// Shared pieces: statistics and page source
+// ============================================================================
+
+static void emit_heap_common(std::ostream& out) {
+    out << R"(
+// ============================================================================
+// Heap Allocator (auto-generated by Coi compiler)
+// ============================================================================
+namespace __coi_heap {
+
+constexpr uint32_t PAGE_SIZE = 65536;
+constexpr uint32_t ALIGN = 8;
+
+inline uint32_t align_up(uint32_t n) { return (n + ALIGN - 1) & ~(ALIGN - 1); }
+
+struct Stats {
+    uint32_t live_allocations = 0;
+    uint32_t live_bytes = 0;
+    uint32_t high_water = 0;      // Peak live_bytes
+    uint32_t reserved_bytes = 0;  // Taken from webcc's allocator
+    void on_alloc(uint32_t size) {
+        live_allocations++;
+        live_bytes += size;
+        if (live_bytes > high_water) high_water = live_bytes;
+    }
+    void on_free(uint32_t size) {
+        live_allocations--;
+        live_bytes -= size;
+    }
+    // Share of the reserved memory that is not holding live data
+    float fragmentation() const {
+        return reserved_bytes ? 1.0f - (float)live_bytes / (float)reserved_bytes : 0.0f;
+    }
+};
+inline Stats stats;
+
+// Pages come from webcc's allocator and are never handed back
+inline char* take_pages(uint32_t size) {
+    stats.reserved_bytes += size;
+    return (char*)webcc::malloc(size);
+}
+)";
+}
+
+// ============================================================================
+// Strategies
+// ============================================================================
+
+static void emit_slab_heap(std::ostream& out) {
+    out << R"(
+// Size-class slabs: power-of-two classes from 16 bytes to 16 KiB. A class carves a whole
+// page into blocks at once and recycles them through its own free list. Larger requests
+// get a block of their own, recycled first-fit.
+struct Heap {
+    struct Header { uint32_t size; uint32_t pad; };
+    struct FreeBlock { FreeBlock* next; };
+    static constexpr uint32_t MIN_CLASS_LOG2 = 4;
+    static constexpr uint32_t CLASS_COUNT = 11;
+    static constexpr uint32_t MAX_CLASS = 1u << (MIN_CLASS_LOG2 + CLASS_COUNT - 1);
+    FreeBlock* classes[CLASS_COUNT] = {};
+    FreeBlock* large = nullptr;
+
+    static Header* header(void* p) { return (Header*)((char*)p - sizeof(Header)); }
+    static uint32_t class_of(uint32_t size) {
+        uint32_t c = 0;
+        while ((1u << (c + MIN_CLASS_LOG2)) < size) c++;
+        return c;
+    }
+    void refill(uint32_t c) {
+        uint32_t size = 1u << (c + MIN_CLASS_LOG2);
+        uint32_t stride = sizeof(Header) + size;
+        char* slab = take_pages(PAGE_SIZE);
+        for (uint32_t offset = 0; offset + stride <= PAGE_SIZE; offset += stride) {
+            char* p = slab + offset + sizeof(Header);
+            header(p)->size = size;
+            ((FreeBlock*)p)->next = classes[c];
+            classes[c] = (FreeBlock*)p;
+        }
+    }
+    void* alloc(uint32_t n) {
+        uint32_t size = n ? n : 1;
+        char* p = nullptr;
+        if (size <= MAX_CLASS) {
+            uint32_t c = class_of(size);
+            if (!classes[c]) refill(c);
+            p = (char*)classes[c];
+            classes[c] = classes[c]->next;
+        } else {
+            size = align_up(size);
+            for (FreeBlock** link = &large; *link; link = &(*link)->next) {
+                if (header(*link)->size >= size) {
+                    p = (char*)*link;
+                    *link = (*link)->next;
+                    break;
+                }
+            }
+            if (!p) {
+                p = take_pages(sizeof(Header) + size) + sizeof(Header);
+                header(p)->size = size;
+            }
+        }
+        stats.on_alloc(header(p)->size);
+        return p;
+    }
+    void free(void* ptr) {
+        if (!ptr) return;
+        uint32_t size = header(ptr)->size;
+        stats.on_free(size);
+        FreeBlock* block = (FreeBlock*)ptr;
+        FreeBlock*& list = size <= MAX_CLASS ? classes[class_of(size)] : large;
+        block->next = list;
+        list = block;
+    }
+};
+)";
+}
+
+static void emit_tlsf_heap(std::ostream& out) {
+    out << R"(
+// Two-level segregated fit: free blocks are binned by power of two and 16 linear steps
+// within it, and a fitting bin is found through two bitmaps in constant time. Blocks are
+// split on allocation and merged with free neighbours on release.
+struct Heap {
+    struct Block {
+        Block* prev_phys;  // Physically previous block (nullptr for the first block of a pool)
+        uint32_t size;     // Payload bytes
+        uint32_t is_free;
+        Block* next_free;  // Free-list links overlay the payload while the block is free
+        Block* prev_free;
+    };
+    static constexpr uint32_t HEADER = (__builtin_offsetof(Block, next_free) + ALIGN - 1) & ~(ALIGN - 1);
+    static constexpr uint32_t MIN_PAYLOAD = (2 * sizeof(Block*) + ALIGN - 1) & ~(ALIGN - 1);
+    static constexpr int SL_LOG2 = 4;
+    static constexpr int SL_COUNT = 1 << SL_LOG2;
+    static constexpr int FL_SHIFT = SL_LOG2 + 3;
+    static constexpr uint32_t SMALL_BLOCK = 1u << FL_SHIFT;
+    static constexpr int FL_COUNT = 32 - FL_SHIFT + 1;
+    uint32_t fl_bitmap = 0;
+    uint32_t sl_bitmap[FL_COUNT] = {};
+    Block* lists[FL_COUNT][SL_COUNT] = {};
+
+    static int fls(uint32_t x) { return 31 - __builtin_clz(x); }
+    static int ffs(uint32_t x) { return __builtin_ctz(x); }
+    static Block* next_phys(Block* b) { return (Block*)((char*)b + HEADER + b->size); }
+    static void mapping(uint32_t size, int& fl, int& sl) {
+        if (size < SMALL_BLOCK) {
+            fl = 0;
+            sl = (int)(size / (SMALL_BLOCK / SL_COUNT));
+        } else {
+            fl = fls(size);
+            sl = (int)((size >> (fl - SL_LOG2)) ^ (1u << SL_LOG2));
+            fl -= FL_SHIFT - 1;
+        }
+    }
+    // Round up to the next bin boundary so every block in the bin found is large enough
+    static uint32_t round_to_bin(uint32_t size) {
+        return size >= SMALL_BLOCK ? size + (1u << (fls(size) - SL_LOG2)) - 1 : size;
+    }
+    void insert(Block* b) {
+        int fl, sl;
+        mapping(b->size, fl, sl);
+        b->is_free = 1;
+        b->prev_free = nullptr;
+        b->next_free = lists[fl][sl];
+        if (b->next_free) b->next_free->prev_free = b;
+        lists[fl][sl] = b;
+        fl_bitmap |= 1u << fl;
+        sl_bitmap[fl] |= 1u << sl;
+    }
+    void remove(Block* b) {
+        int fl, sl;
+        mapping(b->size, fl, sl);
+        if (b->prev_free) b->prev_free->next_free = b->next_free;
+        else lists[fl][sl] = b->next_free;
+        if (b->next_free) b->next_free->prev_free = b->prev_free;
+        if (!lists[fl][sl]) {
+            sl_bitmap[fl] &= ~(1u << sl);
+            if (!sl_bitmap[fl]) fl_bitmap &= ~(1u << fl);
+        }
+        b->is_free = 0;
+    }
+    Block* find(uint32_t size) {
+        int fl, sl;
+        mapping(round_to_bin(size), fl, sl);
+        if (fl >= FL_COUNT) return nullptr;
+        uint32_t sl_map = sl_bitmap[fl] & (~0u << sl);
+        if (!sl_map) {
+            uint32_t fl_map = fl + 1 < 32 ? fl_bitmap & (~0u << (fl + 1)) : 0;
+            if (!fl_map) return nullptr;
+            fl = ffs(fl_map);
+            sl_map = sl_bitmap[fl];
+        }
+        return lists[fl][ffs(sl_map)];
+    }
+    // A pool is one free block followed by a zero-size used sentinel that stops merging
+    void add_pool(uint32_t size) {
+        uint32_t bytes = align_up(round_to_bin(size)) + 2 * HEADER;
+        if (bytes < PAGE_SIZE) bytes = PAGE_SIZE;
+        Block* first = (Block*)take_pages(bytes);
+        first->prev_phys = nullptr;
+        first->size = bytes - 2 * HEADER;
+        Block* sentinel = next_phys(first);
+        sentinel->prev_phys = first;
+        sentinel->size = 0;
+        sentinel->is_free = 0;
+        insert(first);
+    }
+    void* alloc(uint32_t n) {
+        uint32_t size = align_up(n ? n : 1);
+        if (size < MIN_PAYLOAD) size = MIN_PAYLOAD;
+        Block* b = find(size);
+        if (!b) {
+            add_pool(size);
+            b = find(size);
+        }
+        remove(b);
+        if (b->size >= size + HEADER + MIN_PAYLOAD) {
+            Block* rest = (Block*)((char*)b + HEADER + size);
+            rest->prev_phys = b;
+            rest->size = b->size - size - HEADER;
+            next_phys(rest)->prev_phys = rest;
+            b->size = size;
+            insert(rest);
+        }
+        stats.on_alloc(b->size);
+        return (char*)b + HEADER;
+    }
+    void free(void* ptr) {
+        if (!ptr) return;
+        Block* b = (Block*)((char*)ptr - HEADER);
+        stats.on_free(b->size);
+        Block* prev = b->prev_phys;
+        if (prev && prev->is_free) {
+            remove(prev);
+            prev->size += HEADER + b->size;
+            b = prev;
+            next_phys(b)->prev_phys = b;
+        }
+        Block* next = next_phys(b);
+        if (next->is_free) {
+            remove(next);
+            b->size += HEADER + next->size;
+            next_phys(b)->prev_phys = b;
+        }
+        insert(b);
+    }
+};
+)";
+}
+
+static void emit_bump_heap(std::ostream& out) {
+    out << R"(
+// Bump allocation through pages. Freed blocks are recycled through exact-size free lists
+// up to 512 bytes and a first-fit list above; nothing is split or merged.
+struct Heap {
+    struct Header { uint32_t size; uint32_t pad; };
+    struct FreeBlock { FreeBlock* next; };
+    static constexpr uint32_t SMALL_LIMIT = 512;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    FreeBlock* bins[SMALL_LIMIT / ALIGN] = {};
+    FreeBlock* large = nullptr;
+
+    static Header* header(void* p) { return (Header*)((char*)p - sizeof(Header)); }
+    void* alloc(uint32_t n) {
+        uint32_t size = align_up(n ? n : 1);
+        char* p = nullptr;
+        if (size <= SMALL_LIMIT) {
+            FreeBlock*& bin = bins[size / ALIGN - 1];
+            if (bin) {
+                p = (char*)bin;
+                bin = bin->next;
+            }
+        } else {
+            for (FreeBlock** link = &large; *link; link = &(*link)->next) {
+                if (header(*link)->size >= size) {
+                    p = (char*)*link;
+                    *link = (*link)->next;
+                    break;
+                }
+            }
+        }
+        if (!p) {
+            uint32_t total = sizeof(Header) + size;
+            if (!cursor || (uint32_t)(limit - cursor) < total) {
+                uint32_t page = total > PAGE_SIZE ? total : PAGE_SIZE;
+                cursor = take_pages(page);
+                limit = cursor + page;
+            }
+            p = cursor + sizeof(Header);
+            cursor += total;
+            header(p)->size = size;
+        }
+        stats.on_alloc(header(p)->size);
+        return p;
+    }
+    void free(void* ptr) {
+        if (!ptr) return;
+        uint32_t size = header(ptr)->size;
+        stats.on_free(size);
+        FreeBlock* block = (FreeBlock*)ptr;
+        FreeBlock*& list = size <= SMALL_LIMIT ? bins[size / ALIGN - 1] : large;
+        block->next = list;
+        list = block;
+    }
+};
+)";
+}
+
+void emit_heap_runtime(std::ostream& out, const std::string& allocator) {
+    emit_heap_common(out);
+    if (allocator == "slab") {
+        emit_slab_heap(out);
+    } else if (allocator == "tlsf") {
+        emit_tlsf_heap(out);
+    } else {
+        emit_bump_heap(out);
+    }
+    out << R"(
+inline Heap heap;
+
+} // namespace __coi_heap
+)";
+}
+
+// ============================================================================
+// Debug-build memory telemetry
+// ============================================================================
+
+void emit_memory_telemetry_runtime(std::ostream& out) {
+    out << R"(
+// ============================================================================
+// Component Memory Telemetry (auto-generated by Coi compiler, debug builds)
+// ============================================================================
+namespace __coi_mem {
+
+// One record per component type, listed once its first instance is constructed
+struct ComponentMemory {
+    const char* name;
+    int32_t live = 0;
+    int32_t peak = 0;
+    int32_t mounted = 0;
+    uint32_t owned_bytes = 0;
+    ComponentMemory* next = nullptr;
+    bool listed = false;
+};
+inline ComponentMemory* components = nullptr;
+
+// Heap bytes held by a member; values without heap storage count nothing
+template<typename T> inline uint32_t owned_bytes(const T&) { return 0; }
+inline uint32_t owned_bytes(const coi::string& s) { return s.length(); }
+template<typename K, typename V> inline uint32_t owned_bytes(const coi::map<K, V>& m) {
+    return m.size() * (sizeof(K) + sizeof(V));
+}
+template<typename T> inline uint32_t owned_bytes(const coi::vector<T>& v) {
+    uint32_t n = v.size() * sizeof(T);
+    for (uint32_t i = 0; i < v.size(); i++) n += owned_bytes(v[i]);
+    return n;
+}
+constexpr uint32_t DISPATCHER_ENTRY_BYTES = sizeof(int32_t) + sizeof(coi::function<void()>);
+
+// Last data member of every component: counts instances as they are constructed, copied
+// and destroyed, and holds what the instance last reported in owned_bytes
+template<typename T>
+struct InstanceTracker {
+    uint32_t bytes = 0;
+    bool mounted = false;
+    static ComponentMemory& stats() {
+        static ComponentMemory s{T::_component_name()};
+        if (!s.listed) {
+            s.listed = true;
+            s.next = components;
+            components = &s;
+        }
+        return s;
+    }
+    InstanceTracker() { added(); }
+    // A copy holds what the original held, so it adds its bytes and mount state to the totals
+    InstanceTracker(const InstanceTracker& other) {
+        added();
+        update(other.mounted, other.bytes);
+    }
+    InstanceTracker& operator=(const InstanceTracker& other) {
+        update(other.mounted, other.bytes);
+        return *this;
+    }
+    ~InstanceTracker() {
+        ComponentMemory& s = stats();
+        s.live--;
+        if (mounted) s.mounted--;
+        s.owned_bytes -= bytes;
+    }
+    static void added() {
+        ComponentMemory& s = stats();
+        s.live++;
+        if (s.live > s.peak) s.peak = s.live;
+    }
+    // Called from view(), _destroy() and _remove_view() with the instance's current size
+    void update(bool now_mounted, uint32_t now_bytes) {
+        ComponentMemory& s = stats();
+        if (now_mounted != mounted) s.mounted += now_mounted ? 1 : -1;
+        mounted = now_mounted;
+        s.owned_bytes += now_bytes - bytes;
+        bytes = now_bytes;
+    }
+};
+
+inline bool same_name(const char* a, const char* b) {
+    while (*a && *a == *b) { a++; b++; }
+    return *a == *b;
+}
+
+inline ComponentMemory* find(const char* name) {
+    for (ComponentMemory* c = components; c; c = c->next) {
+        if (same_name(c->name, name)) return c;
+    }
+    return nullptr;
+}
+inline ComponentMemory* find(const coi::string& name) { return find(name.c_str()); }
+
+template<typename Name> inline int instances(const Name& name) {
+    ComponentMemory* c = find(name);
+    return c ? c->live : 0;
+}
+template<typename Name> inline int bytes(const Name& name) {
+    ComponentMemory* c = find(name);
+    return c ? (int)c->owned_bytes : 0;
+}
+
+// Every Dispatcher lists its tables here, for the high-water marks and the teardown audit.
+// Element tables (DOM events) hold handles owned by a view; the others (timers, fetch,
+// WebSocket) hold requests and sockets that may outlive the view but not the component.
+struct DispatcherTable;
+inline DispatcherTable* dispatchers = nullptr;
+struct DispatcherTable {
+    const char* name;
+    const int32_t* handles;
+    const void** owners;
+    const int* count;
+    int capacity;
+    bool elements;
+    int high_water = 0;
+    bool overflowed = false;
+    DispatcherTable* next;
+    DispatcherTable(const char* name, bool elements, const int32_t* handles, const void** owners, const int* count, int capacity)
+        : name(name), handles(handles), owners(owners), count(count), capacity(capacity), elements(elements), next(dispatchers) {
+        dispatchers = this;
+    }
+    void grew() {
+        if (*count > high_water) high_water = *count;
+    }
+    void full() {
+        if (overflowed) return;
+        overflowed = true;
+        webcc::hybrid_formatter<128> _fmt;
+        _fmt << "[Coi] " << name << " dispatcher is full (" << capacity << " entries); new handlers are dropped";
+        webcc::system::warn(_fmt.c_str());
+    }
+};
+inline int leaked_handlers = 0;
+
+// Runs at the end of _destroy() (all tables) and _remove_view() (element tables). Any entry
+// still tagged with the instance is a handler some removal site missed; it is untagged so it is
+// reported once. An element table entry keyed to one of the component's element handles but not
+// tagged with it was registered by other code and is reported too. Both keep slowing every
+// dispatch of their table.
+inline void audit_dispatchers(const void* owner, const webcc::handle* els, int el_count, const char* component,
+                              bool elements_only) {
+    for (DispatcherTable* d = dispatchers; d; d = d->next) {
+        if (elements_only && !d->elements) continue;
+        for (int i = 0; i < *d->count; i++) {
+            if (d->owners[i] == owner) {
+                d->owners[i] = nullptr;
+                leaked_handlers++;
+                webcc::hybrid_formatter<128> _fmt;
+                _fmt << "[Coi] " << component << " was torn down with handle " << d->handles[i] << " still in the " << d->name << " dispatcher";
+                webcc::system::warn(_fmt.c_str());
+                continue;
+            }
+            if (!d->elements) continue;
+            for (int e = 0; e < el_count; e++) {
+                if (!els[e].is_valid() || (int32_t)els[e] != d->handles[i]) continue;
+                leaked_handlers++;
+                webcc::hybrid_formatter<128> _fmt;
+                _fmt << "[Coi] " << component << " was torn down with a foreign handler for handle " << d->handles[i] << " in the " << d->name << " dispatcher";
+                webcc::system::warn(_fmt.c_str());
+                break;
+            }
+        }
+    }
+}
+
+inline int dispatcher_high_water(const char* name) {
+    for (DispatcherTable* d = dispatchers; d; d = d->next) {
+        if (same_name(d->name, name)) return d->high_water;
+    }
+    return 0;
+}
+inline int dispatcher_high_water(const coi::string& name) { return dispatcher_high_water(name.c_str()); }
+
+inline void dump() {
+    webcc::system::log("[Coi] Component memory (live / peak / mounted / owned bytes):");
+    for (ComponentMemory* c = components; c; c = c->next) {
+        webcc::hybrid_formatter<256> _fmt;
+        _fmt << "  " << c->name << ": " << c->live << " / " << c->peak << " / " << c->mounted << " / " << (int)c->owned_bytes;
+        webcc::system::log(_fmt.c_str());
+    }
+    if (!dispatchers) return;
+    webcc::system::log("[Coi] Dispatchers (entries / high water / capacity):");
+    for (DispatcherTable* d = dispatchers; d; d = d->next) {
+        webcc::hybrid_formatter<128> _fmt;
+        _fmt << "  " << d->name << ": " << *d->count << " / " << d->high_water << " / " << d->capacity;
+        webcc::system::log(_fmt.c_str());
+    }
+    if (leaked_handlers > 0) {
+        webcc::hybrid_formatter<128> _fmt;
+        _fmt << "  " << leaked_handlers << " handler(s) outlived their component";
+        webcc::system::warn(_fmt.c_str());
+    }
+}
+
+} // namespace __coi_mem
+)";
+}
@@ -0,0 +1,25 @@
+// =============================================================================
+// Heap Allocator Runtime for Coi
+//
+// Emits the allocator selected with `allocator = "..."` in the app block.
+// Coi-owned allocations (the root component, routed components, if-branch
+// children, frame scratch chunks) go through it via coi::malloc / coi::free, and
+// it keeps the statistics behind the Heap core type. Pages are taken from webcc's
+// allocator, which keeps serving webcc's own containers.
+// =============================================================================
+
+#pragma once
+
+#include <ostream>
+#include <string>
+
+// Strategies accepted by `allocator = "..."`
+bool is_heap_allocator(const std::string& name);
+
+// Emit namespace __coi_heap (Stats, Heap, `heap` instance) for the given strategy
+void emit_heap_runtime(std::ostream& out, const std::string& allocator);
+
+// Emit namespace __coi_mem for debug builds: per-component-type live instance counts and
+// owned bytes, kept by an InstanceTracker member of every component, plus the lookups and
+// console dump behind the Memory type
+void emit_memory_telemetry_runtime(std::ostream& out);
@@ -444,19 +444,24 @@ inline coi::string_view isolate(const char* s, uint32_t p, uint32_t len) {
 inline coi::string ext_str(const char* s, uint32_t p, uint32_t len) {
     if (p >= len || s[p] != '"') return {};
     p++;
-    coi::string r;
+    uint32_t end = p;
+    while (end < len && s[end] != '"') { if (s[end] == '\\') end++; end++; }
+    // Unescape into frame scratch so the result is built with a single allocation
+    char* r = (char*)g_frame.alloc(end - p + 1);
+    uint32_t n = 0;
     while (p < len && s[p] != '"') {
         if (s[p] == '\\' && p + 1 < len) {
             p++;
             switch (s[p]) {
-                case '"': r += '"'; break; case '\\': r += '\\'; break;
-                case 'n': r += '\n'; break; case 'r': r += '\r'; break;
-                case 't': r += '\t'; break; default: r += s[p]; break;
+                case '"': r[n++] = '"'; break; case '\\': r[n++] = '\\'; break;
+                case 'n': r[n++] = '\n'; break; case 'r': r[n++] = '\r'; break;
+                case 't': r[n++] = '\t'; break; default: r[n++] = s[p]; break;
             }
-        } else r += s[p];
+        } else r[n++] = s[p];
         p++;
     }
-    return r;
+    r[n] = '\0';
+    return coi::string(r);
 }
 
 inline int32_t ext_int(const char* s, uint32_t p, uint32_t len, bool& ok) {
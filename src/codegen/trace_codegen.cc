@@ -0,0 +1,259 @@
+#include "trace_codegen.h"
+#include <fstream>
+#include <iterator>
+
+static const char* TRACE_MAGIC = "COIT";
+static const uint8_t TRACE_VERSION = 1;
+
+static int base64_value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+static bool decode_base64(const std::string& text, std::vector<uint8_t>& bytes) {
+    uint32_t bits = 0;
+    int count = 0;
+    for (char c : text) {
+        if (c == '=' || c == ' ' || c == '\n' || c == '\r' || c == '\t') continue;
+        int v = base64_value(c);
+        if (v < 0) return false;
+        bits = (bits << 6) | (uint32_t)v;
+        count += 6;
+        if (count >= 8) {
+            count -= 8;
+            bytes.push_back((uint8_t)(bits >> count));
+        }
+    }
+    return true;
+}
+
+bool load_trace_file(const std::string& path, std::vector<uint8_t>& bytes, std::string& error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        error = "cannot read trace file '" + path + "'";
+        return false;
+    }
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    bytes.clear();
+    if (content.compare(0, 4, TRACE_MAGIC) == 0) {
+        bytes.assign(content.begin(), content.end());
+    } else if (!decode_base64(content, bytes)) {
+        error = "'" + path + "' is neither a binary trace nor base64 text";
+        return false;
+    }
+
+    if (bytes.size() < 5 || std::string(bytes.begin(), bytes.begin() + 4) != TRACE_MAGIC) {
+        error = "'" + path + "' is not a Coi event trace";
+        return false;
+    }
+    if (bytes[4] != TRACE_VERSION) {
+        error = "'" + path + "' uses trace format " + std::to_string(bytes[4]) +
+                ", this compiler replays format " + std::to_string(TRACE_VERSION);
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Shared pieces: trace layout and event kinds
+// ============================================================================
+
+static void emit_trace_common(std::ostream& out) {
+    out << R"(
+// ============================================================================
+// Event Trace (auto-generated by Coi compiler)
+// ============================================================================
+namespace __coi_trace {
+
+// Layout (little endian): "COIT", format version, then one record per frame: the number
+// of events (u8), ms since the previous frame (f32), and each event as its kind (u8),
+// target handle (varint, when the event has one) and payload: a zigzag varint number,
+// or a varint length followed by the text and a NUL
+enum Kind : uint8_t {
+    Click = 1, Input, Change, Keydown,
+    KeyDown, KeyUp, Popstate,
+    WsMessage, WsOpen, WsClose, WsError,
+    FetchSuccess, FetchError
+};
+)";
+}
+
+static void emit_trace_recorder(std::ostream& out) {
+    out << R"(
+// Appends every frame to `bytes` and saves the trace (base64) to localStorage under
+// "coi-trace" every 10 seconds of recorded time, and on Trace.save()
+struct Recorder {
+    coi::vector<uint8_t> bytes;
+    coi::vector<char> encoded;  // base64 of bytes, rebuilt by save()
+    uint32_t count_at = 0;
+    uint32_t frames = 0;
+    double clock = 0;  // Timestamp of the last frame as a replay will reconstruct it
+    double next_save = 10000;
+    Recorder() {
+        put('C'); put('O'); put('I'); put('T'); put(1);
+    }
+    void put(uint8_t b) { bytes.push_back(b); }
+    void varint(uint32_t v) {
+        while (v >= 0x80) { put((uint8_t)(v | 0x80)); v >>= 7; }
+        put((uint8_t)v);
+    }
+    void begin_frame(double time) {
+        float delta = (float)(time - clock);
+        clock += delta;
+        count_at = bytes.size();
+        put(0);
+        uint32_t bits;
+        __builtin_memcpy(&bits, &delta, 4);
+        for (int i = 0; i < 4; i++) put((uint8_t)(bits >> (i * 8)));
+        frames++;
+    }
+    void event(Kind kind) {
+        bytes[count_at]++;
+        put(kind);
+    }
+    void handle(int32_t h) { varint((uint32_t)h); }
+    void number(int32_t n) { varint(((uint32_t)n << 1) ^ (uint32_t)(n >> 31)); }
+    void text(const coi::string& s) {
+        varint(s.length());
+        const char* p = s.data();
+        for (uint32_t i = 0; i < s.length(); i++) put((uint8_t)p[i]);
+        put(0);
+    }
+    void end_frame() {
+        if (clock < next_save) return;
+        next_save = clock + 10000;
+        save();
+    }
+    void save() {
+        static const char* digits = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        encoded.clear();
+        uint32_t n = bytes.size();
+        for (uint32_t i = 0; i < n; i += 3) {
+            uint32_t v = (uint32_t)bytes[i] << 16;
+            if (i + 1 < n) v |= (uint32_t)bytes[i + 1] << 8;
+            if (i + 2 < n) v |= bytes[i + 2];
+            encoded.push_back(digits[(v >> 18) & 63]);
+            encoded.push_back(digits[(v >> 12) & 63]);
+            encoded.push_back(i + 1 < n ? digits[(v >> 6) & 63] : '=');
+            encoded.push_back(i + 2 < n ? digits[v & 63] : '=');
+        }
+        encoded.push_back(0);
+        webcc::storage::set_item(coi::string("coi-trace"), coi::string(&encoded[0]));
+        webcc::hybrid_formatter<128> _fmt;
+        _fmt << "[Coi] Saved trace to localStorage 'coi-trace': " << (int)frames << " frames, " << (int)n << " bytes";
+        webcc::system::log(_fmt.c_str());
+    }
+};
+
+} // namespace __coi_trace
+
+__coi_trace::Recorder g_trace;
+)";
+}
+
+static void emit_trace_player(std::ostream& out, const std::vector<uint8_t>& trace) {
+    out << "\n// Recorded trace replayed by this build\n";
+    out << "inline constexpr uint8_t TRACE[" << trace.size() << "] = {";
+    for (size_t i = 0; i < trace.size(); i++) {
+        if (i % 24 == 0) out << "\n    ";
+        out << (int)trace[i] << ",";
+    }
+    out << "\n};\n";
+    out << R"(
+// Feeds one recorded frame per animation frame in place of live events and times each
+// frame from its events to its DOM flush; reports the per-frame cost once the trace ends
+struct Player {
+    const uint8_t* p = TRACE + 5;
+    const uint8_t* end = TRACE + sizeof(TRACE);
+    double clock = 0;
+    double started = 0;
+    uint32_t frames = 0;
+    double total_ms = 0;
+    double max_ms = 0;
+    uint32_t histogram[501] = {};  // 0.1 ms buckets; the last one holds 50 ms and up
+    bool active() const { return p < end; }
+    uint8_t byte() { return *p++; }
+    uint32_t varint() {
+        uint32_t v = 0;
+        for (int shift = 0; p < end; shift += 7) {
+            uint8_t b = *p++;
+            v |= (uint32_t)(b & 0x7f) << shift;
+            if (!(b & 0x80)) break;
+        }
+        return v;
+    }
+    int32_t handle() { return (int32_t)varint(); }
+    int32_t number() {
+        uint32_t v = varint();
+        return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+    }
+    coi::string text() {
+        uint32_t n = varint();
+        const char* s = (const char*)p;
+        p += n + 1;
+        return coi::string(s);
+    }
+    // Returns the recorded frame timestamp and its event count
+    double begin_frame(uint32_t& count) {
+        count = byte();
+        uint32_t bits = 0;
+        for (int i = 0; i < 4; i++) bits |= (uint32_t)byte() << (i * 8);
+        float delta;
+        __builtin_memcpy(&delta, &bits, 4);
+        clock += delta;
+        started = webcc::system::get_time();
+        return clock;
+    }
+    void end_frame() {
+        double ms = (webcc::system::get_time() - started) * 1000.0;
+        frames++;
+        total_ms += ms;
+        if (ms > max_ms) max_ms = ms;
+        uint32_t bucket = (uint32_t)(ms * 10.0);
+        histogram[bucket < 500 ? bucket : 500]++;
+        if (!active()) report();
+    }
+    // A kind this build does not handle: the trace comes from a different app
+    void stop() {
+        p = end;
+        webcc::system::warn("[Coi] Trace does not match this app; replay stopped");
+    }
+    double percentile(uint32_t pct) const {
+        uint32_t target = (frames * pct + 99) / 100;
+        uint32_t seen = 0;
+        for (uint32_t i = 0; i <= 500; i++) {
+            seen += histogram[i];
+            // Upper edge of the bucket, which may overshoot the slowest frame
+            if (seen >= target) return (i + 1) * 0.1 < max_ms ? (i + 1) * 0.1 : max_ms;
+        }
+        return max_ms;
+    }
+    void report() {
+        webcc::hybrid_formatter<256> _fmt;
+        _fmt << "[Coi] Replayed " << (int)frames << " frames in " << (float)total_ms << " ms: mean "
+             << (float)(frames ? total_ms / frames : 0.0) << " ms, p50 " << (float)percentile(50)
+             << " ms, p95 " << (float)percentile(95) << " ms, p99 " << (float)percentile(99)
+             << " ms, max " << (float)max_ms << " ms";
+        webcc::system::log(_fmt.c_str());
+    }
+};
+
+} // namespace __coi_trace
+
+__coi_trace::Player g_replay;
+)";
+}
+
+void emit_trace_runtime(std::ostream& out, const TraceOptions& trace) {
+    emit_trace_common(out);
+    if (!trace.replay.empty()) {
+        emit_trace_player(out, trace.replay);
+    } else {
+        emit_trace_recorder(out);
+    }
+}
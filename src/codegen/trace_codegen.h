@@ -0,0 +1,30 @@
+// =============================================================================
+// Event Trace Runtime for Coi
+//
+// `--record` builds log every polled event the app reacts to, with the frame
+// timestamps, into a compact binary trace that is saved to localStorage.
+// `--replay <trace>` builds embed such a trace and feed it back, one recorded
+// frame per animation frame, in place of live events, measuring how long each
+// frame takes. A captured session then becomes a repeatable benchmark.
+// =============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct TraceOptions {
+    bool record = false;
+    // Decoded trace to replay (empty when not replaying)
+    std::vector<uint8_t> replay;
+};
+
+// Read a trace saved by a --record build: the raw bytes, or the base64 text the recorder
+// stores in localStorage. Returns false and sets error when the file is not a trace.
+bool load_trace_file(const std::string& path, std::vector<uint8_t>& bytes, std::string& error);
+
+// Emit namespace __coi_trace with the event kinds and the recorder (g_trace) or the
+// player (g_replay) holding the embedded trace
+void emit_trace_runtime(std::ostream& out, const TraceOptions& trace);
@@ -0,0 +1,178 @@
+#include "tree_shaker.h"
+#include <cctype>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+struct ShakeRegion
+{
+    int parent = -1;
+    std::vector<std::string> symbols;
+    // Own text and child regions, in order; a negative entry -1 - i stands for child region i
+    std::vector<std::string> text;
+    std::vector<int> layout;
+    std::vector<int> children;
+    bool referenced = false;
+    bool kept = false;
+};
+
+static const char *REGION_BEGIN = "//@region";
+static const char *REGION_END = "//@endregion";
+
+static bool is_ident_start(char c)
+{
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+static bool is_ident_char(char c)
+{
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Parse marker lines into a region tree; region 0 is everything outside markers
+static std::vector<ShakeRegion> parse_regions(const std::string &code)
+{
+    std::vector<ShakeRegion> regions(1);
+    int current = 0;
+    std::string pending;
+
+    auto flush_text = [&]()
+    {
+        if (pending.empty())
+            return;
+        ShakeRegion &region = regions[current];
+        region.layout.push_back(static_cast<int>(region.text.size()));
+        region.text.push_back(std::move(pending));
+        pending.clear();
+    };
+
+    std::istringstream lines(code);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        size_t start = line.find_first_not_of(" \t");
+        std::string trimmed = start == std::string::npos ? "" : line.substr(start);
+        if (trimmed.rfind(REGION_END, 0) == 0 && current != 0)
+        {
+            flush_text();
+            current = regions[current].parent;
+            continue;
+        }
+        if (trimmed.rfind(REGION_BEGIN, 0) == 0)
+        {
+            flush_text();
+            ShakeRegion region;
+            region.parent = current;
+            std::istringstream symbols(trimmed.substr(std::string(REGION_BEGIN).size()));
+            std::string symbol;
+            while (symbols >> symbol)
+                region.symbols.push_back(symbol);
+
+            int id = static_cast<int>(regions.size());
+            regions[current].layout.push_back(-1 - static_cast<int>(regions[current].children.size()));
+            regions[current].children.push_back(id);
+            regions.push_back(std::move(region));
+            current = id;
+            continue;
+        }
+        pending += line;
+        pending += '\n';
+    }
+    flush_text();
+    return regions;
+}
+
+static void collect_identifiers(const std::string &text, std::unordered_set<std::string> &out)
+{
+    size_t pos = 0;
+    while (pos < text.size())
+    {
+        if (!is_ident_start(text[pos]))
+        {
+            // Skip the tail of numbers like 0x1f so their letters are not read as identifiers
+            bool number = std::isdigit(static_cast<unsigned char>(text[pos]));
+            pos++;
+            while (number && pos < text.size() && is_ident_char(text[pos]))
+                pos++;
+            continue;
+        }
+        size_t start = pos;
+        while (pos < text.size() && is_ident_char(text[pos]))
+            pos++;
+        out.insert(text.substr(start, pos - start));
+    }
+}
+
+static void write_kept(const std::vector<ShakeRegion> &regions, int id, std::string &out)
+{
+    const ShakeRegion &region = regions[id];
+    for (int entry : region.layout)
+    {
+        if (entry >= 0)
+        {
+            out += region.text[entry];
+            continue;
+        }
+        int child = region.children[-1 - entry];
+        if (regions[child].kept)
+            write_kept(regions, child, out);
+    }
+}
+
+std::string tree_shake(const std::string &code)
+{
+    std::vector<ShakeRegion> regions = parse_regions(code);
+
+    std::unordered_map<std::string, std::vector<int>> defined_by;
+    for (size_t id = 1; id < regions.size(); ++id)
+    {
+        for (const auto &symbol : regions[id].symbols)
+            defined_by[symbol].push_back(static_cast<int>(id));
+    }
+
+    // Worklist over kept regions: every identifier a kept region uses references the regions
+    // defining it, which are kept as soon as their enclosing region is
+    std::vector<int> worklist = {0};
+    regions[0].kept = true;
+    auto keep = [&](int id)
+    {
+        if (!regions[id].kept)
+        {
+            regions[id].kept = true;
+            worklist.push_back(id);
+        }
+    };
+
+    while (!worklist.empty())
+    {
+        int id = worklist.back();
+        worklist.pop_back();
+
+        for (int child : regions[id].children)
+        {
+            if (regions[child].referenced)
+                keep(child);
+        }
+
+        std::unordered_set<std::string> identifiers;
+        for (const auto &text : regions[id].text)
+            collect_identifiers(text, identifiers);
+        for (const auto &identifier : identifiers)
+        {
+            auto it = defined_by.find(identifier);
+            if (it == defined_by.end())
+                continue;
+            for (int target : it->second)
+            {
+                regions[target].referenced = true;
+                if (regions[regions[target].parent].kept)
+                    keep(target);
+            }
+        }
+    }
+
+    std::string out;
+    out.reserve(code.size());
+    write_kept(regions, 0, out);
+    return out;
+}
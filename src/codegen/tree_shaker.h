@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Generated code is wrapped in regions that name the symbols they define (a component, a method,
+// a data type, ...). tree_shake() keeps a region only when one of its symbols is referenced from
+// code that is itself kept, starting from everything outside any region (main, globals, runtime).
+// Nested regions are kept only when their enclosing region is kept.
+// Markers are plain comment lines, so unshaken output still compiles.
+
+inline std::string shake_region_begin(const std::vector<std::string> &symbols)
+{
+    std::string marker = "//@region";
+    for (const auto &symbol : symbols)
+    {
+        marker += " " + symbol;
+    }
+    return marker + "\n";
+}
+
+inline std::string shake_region_end()
+{
+    return "//@endregion\n";
+}
+
+// Drop unreferenced regions and strip all region markers
+std::string tree_shake(const std::string &code);
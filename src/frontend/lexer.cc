@@ -180,6 +180,8 @@ Token Lexer::read_identifier(){
         {"router", TokenType::ROUTER},
         {"module", TokenType::MODULE},
         {"match", TokenType::MATCH},
+        {"async", TokenType::ASYNC},
+        {"await", TokenType::AWAIT},
     };
 
     auto it = keywords.find(id);
@@ -1,6 +1,7 @@
 #include "parser.h"
 #include "defs/def_parser.h"
 #include "cli/error.h"
+#include "codegen/heap_codegen.h"
 #include <stdexcept>
 #include <cctype>
 
@@ -262,6 +263,16 @@ void Parser::parse_app()
             app_config.lang = current().value;
             expect(TokenType::STRING_LITERAL, "Expected string");
         }
+        else if (key == "allocator")
+        {
+            app_config.allocator = current().value;
+            int line = current().line;
+            expect(TokenType::STRING_LITERAL, "Expected string");
+            if (!is_heap_allocator(app_config.allocator))
+            {
+                throw std::runtime_error("Unknown allocator '" + app_config.allocator + "' at line " + std::to_string(line) + " (expected \"slab\", \"tlsf\" or \"bump\")");
+            }
+        }
         else if (key == "routes")
         {
             expect(TokenType::LBRACE, "Expected '{'");
@@ -503,6 +514,34 @@ Component Parser::parse_component()
             advance();
         }
 
+        // Check for async keyword (async def)
+        bool is_async = false;
+        if (current().type == TokenType::ASYNC)
+        {
+            is_async = true;
+            advance();
+            if (current().type != TokenType::DEF || is_mutable)
+            {
+                ErrorHandler::compiler_error("'async' can only be used on method definitions (async def)", current().line);
+            }
+        }
+
+        // Check for computed modifier (contextual: `computed int total = a + b;`)
+        bool is_computed = false;
+        if (current().type == TokenType::IDENTIFIER && current().value == "computed" &&
+            (peek().type == TokenType::INT || peek().type == TokenType::STRING ||
+             peek().type == TokenType::FLOAT || peek().type == TokenType::FLOAT32 ||
+             peek().type == TokenType::BOOL || peek().type == TokenType::IDENTIFIER))
+        {
+            is_computed = true;
+            int computed_line = current().line;
+            advance();
+            if (is_public || is_mutable || is_shared)
+            {
+                ErrorHandler::compiler_error("'computed' members cannot be combined with pub, mut or shared", computed_line);
+            }
+        }
+
         // Variable declaration (note: VOID not valid here, only in return types)
         if (current().type == TokenType::INT || current().type == TokenType::STRING ||
             current().type == TokenType::FLOAT || current().type == TokenType::FLOAT32 ||
@@ -693,6 +732,15 @@ Component Parser::parse_component()
                 throw std::runtime_error("Reference variable '" + var_decl->name + "' must be initialized immediately.");
             }
 
+            if (is_computed)
+            {
+                if (var_decl->is_reference || !var_decl->initializer)
+                {
+                    ErrorHandler::compiler_error("Computed member '" + var_decl->name + "' must be a value type with an initializer expression", current().line);
+                }
+                var_decl->is_computed = true;
+            }
+
             // Track component-type members for view parsing (e.g., "mut Test a;" -> can use <a/> in view)
             // Component types start with uppercase and are not arrays
             if (!var_decl->type.empty() && std::isupper(var_decl->type[0]) &&
@@ -740,6 +788,7 @@ Component Parser::parse_component()
             advance();
             FunctionDef func;
             func.is_public = is_public;
+            func.is_async = is_async;
             func.name = current().value;
             int func_line = current().line;
             expect(TokenType::IDENTIFIER, "Expected function name");
@@ -939,6 +988,14 @@ Component Parser::parse_component()
             // Single return type
             func.return_type = current().value;
             advance();
+            if (func.is_async && func.return_type != "void")
+            {
+                ErrorHandler::compiler_error("async def '" + func.name + "' must return void", func_line);
+            }
+            if (func.is_async && !func.type_params.empty())
+            {
+                ErrorHandler::compiler_error("async def '" + func.name + "' cannot be generic", func_line);
+            }
             expect(TokenType::LBRACE, "Expected '{'");
 
             while (current().type != TokenType::RBRACE)
@@ -222,6 +222,16 @@ std::unique_ptr<Expression> Parser::parse_unary()
         auto operand = parse_unary();
         return std::make_unique<MoveExpression>(std::move(operand));
     }
+    // Await expression: await FetchRequest.get(url) (only valid inside async def)
+    if (current().type == TokenType::AWAIT)
+    {
+        int line = current().line;
+        advance();
+        auto operand = parse_unary();
+        auto await_expr = std::make_unique<AwaitExpr>(std::move(operand));
+        await_expr->line = line;
+        return await_expr;
+    }
     return parse_postfix();
 }
 
@@ -375,6 +375,14 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
             advance(); // consume identifier part
         }
 
+        // Event modifiers (e.g., oninput:debounce={150}, onclick:throttle={500})
+        if (attrName.starts_with("on") && current().type == TokenType::COLON && peek().type == TokenType::IDENTIFIER)
+        {
+            advance(); // consume ':'
+            attrName += ":" + current().value;
+            advance(); // consume modifier name
+        }
+
         std::unique_ptr<Expression> attrValue;
         if (match(TokenType::ASSIGN))
         {
@@ -532,6 +540,7 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
 {
     // Syntax: <if condition> ... <else> ... </else> </if>
     //     or: <if condition> ... </if>
+    //     or: <if condition keep> ... </if>  (branches are built once, then shown and hidden)
     auto viewIf = std::make_unique<ViewIfStatement>();
     viewIf->line = current().line;
 
@@ -541,6 +550,11 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
     // Parse condition (everything until '>')
     // Use parse_expression_no_gt so > is not treated as comparison
     viewIf->condition = parse_expression_no_gt();
+    if (current().type == TokenType::IDENTIFIER && current().value == "keep" && peek().type == TokenType::GT)
+    {
+        viewIf->keep = true;
+        advance(); // consume 'keep'
+    }
     expect(TokenType::GT, "Expected '>'");
 
     // Helper lambdas for termination checks
@@ -102,12 +102,41 @@ int main(int argc, char **argv)
 
     if (first_arg == "build")
     {
-        return build_project(keep_cc, cc_only);
+        bool release = false;
+        bool debug = false;
+        bool record = false;
+        std::string replay;
+        for (int i = 2; i < argc; ++i)
+        {
+            if (std::string(argv[i]) == "--release")
+            {
+                release = true;
+            }
+            else if (std::string(argv[i]) == "--debug")
+            {
+                debug = true;
+            }
+            else if (std::string(argv[i]) == "--record")
+            {
+                record = true;
+            }
+            else if (std::string(argv[i]) == "--replay")
+            {
+                if (i + 1 >= argc)
+                {
+                    ErrorHandler::cli_error("--replay requires a trace file");
+                    return 1;
+                }
+                replay = fs::absolute(argv[++i]).string();
+            }
+        }
+        return build_project(keep_cc, cc_only, false, release, debug, record, replay);
     }
 
     if (first_arg == "dev")
     {
         bool hot_reloading = true;  // Hot reload is now the default
+        bool debug = false;
         for (int i = 2; i < argc; ++i)
         {
             std::string arg = argv[i];
@@ -115,8 +144,12 @@ int main(int argc, char **argv)
             {
                 hot_reloading = false;
             }
+            else if (arg == "--debug")
+            {
+                debug = true;
+            }
         }
-        return dev_project(keep_cc, cc_only, hot_reloading);
+        return dev_project(keep_cc, cc_only, hot_reloading, debug);
     }
 
     if (first_arg == "self-upgrade")
@@ -124,17 +157,31 @@ int main(int argc, char **argv)
         return self_upgrade();
     }
 
-    // Package management commands
+    // Package management commands (--offline resolves from the local registry cache)
+    std::vector<std::string> pkg_args;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--offline")
+        {
+            set_registry_offline(true);
+        }
+        else
+        {
+            pkg_args.push_back(arg);
+        }
+    }
+
     if (first_arg == "add")
     {
-        if (argc < 3)
+        if (pkg_args.empty())
         {
             std::cerr << colors::RED << "Error:" << colors::RESET << " Package name required" << std::endl;
-            std::cerr << "  Usage: coi add <scope/name> [version]" << std::endl;
+            std::cerr << "  Usage: coi add <scope/name> [version] [--offline]" << std::endl;
             return 1;
         }
-        std::string requested_version = (argc >= 4) ? argv[3] : "";
-        return add_package(argv[2], requested_version);
+        std::string requested_version = (pkg_args.size() >= 2) ? pkg_args[1] : "";
+        return add_package(pkg_args[0], requested_version);
     }
 
     if (first_arg == "install")
@@ -160,9 +207,9 @@ int main(int argc, char **argv)
 
     if (first_arg == "upgrade")
     {
-        if (argc >= 3)
+        if (!pkg_args.empty())
         {
-            return update_package(argv[2]);
+            return update_package(pkg_args[0]);
         }
         return update_all_packages();
     }
@@ -172,6 +219,9 @@ int main(int argc, char **argv)
 
     std::string input_file;
     std::string output_dir;
+    bool release = false;
+    bool debug = false;
+    TraceOptions trace;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -180,6 +230,26 @@ int main(int argc, char **argv)
             cc_only = true;
         else if (arg == "--keep-cc")
             keep_cc = true;
+        else if (arg == "--release")
+            release = true;
+        else if (arg == "--debug")
+            debug = true;
+        else if (arg == "--record")
+            trace.record = true;
+        else if (arg == "--replay")
+        {
+            std::string error;
+            if (i + 1 >= argc)
+            {
+                ErrorHandler::cli_error("--replay requires a trace file");
+                return 1;
+            }
+            if (!load_trace_file(argv[++i], trace.replay, error))
+            {
+                ErrorHandler::cli_error(error);
+                return 1;
+            }
+        }
         else if (arg == "--out" || arg == "-o")
         {
             if (i + 1 < argc)
@@ -207,6 +277,12 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    if (trace.record && !trace.replay.empty())
+    {
+        ErrorHandler::cli_error("--record and --replay cannot be combined");
+        return 1;
+    }
+
     // Determine project root (where .coi/pkgs/ lives)
     // If input is src/App.coi, project root is the parent of src/
     fs::path project_root;
@@ -234,8 +310,8 @@ int main(int argc, char **argv)
     AppConfig final_app_config;
     std::set<std::string> processed_files;
     std::queue<std::string> file_queue;
-    // Track direct imports for each file (file -> set of directly imported files)
-    std::map<std::string, std::set<std::string>> file_imports;
+    // Import graph between files; answers visibility including pub import re-exports
+    ModuleGraph module_graph;
     // Track pub imports for re-export resolution (file -> set of pub imported files)
     std::map<std::string, std::set<std::string>> pub_imports;
 
@@ -376,49 +452,17 @@ int main(int argc, char **argv)
                     return 1;
                 }
             }
-            file_imports[current_file_path] = std::move(direct_imports);
+            module_graph.set_imports(current_file_path, direct_imports, current_pub_imports);
             if (!current_pub_imports.empty())
             {
                 pub_imports[current_file_path] = std::move(current_pub_imports);
             }
         }
 
-        // Expand file_imports to include transitively re-exported files via pub imports
-        // If A imports B and B has `pub import C`, then A should also have access to C's exports
-        bool changed = true;
-        while (changed)
-        {
-            changed = false;
-            for (auto &[file, imports] : file_imports)
-            {
-                std::set<std::string> to_add;
-                for (const auto &imported_file : imports)
-                {
-                    // Check if imported_file has pub imports
-                    auto pub_it = pub_imports.find(imported_file);
-                    if (pub_it != pub_imports.end())
-                    {
-                        for (const auto &reexported : pub_it->second)
-                        {
-                            if (imports.find(reexported) == imports.end())
-                            {
-                                to_add.insert(reexported);
-                            }
-                        }
-                    }
-                }
-                if (!to_add.empty())
-                {
-                    imports.insert(to_add.begin(), to_add.end());
-                    changed = true;
-                }
-            }
-        }
-
         std::cerr << "All files processed. Total components: " << all_components.size() << std::endl;
 
-        validate_view_hierarchy(all_components, file_imports);
-        validate_type_imports(all_components, all_global_enums, all_global_data, file_imports);
+        validate_view_hierarchy(all_components, module_graph);
+        validate_type_imports(all_components, all_global_enums, all_global_data, module_graph);
         validate_mutability(all_components);
         validate_types(all_components, all_global_enums, all_global_data);
 
@@ -478,10 +522,24 @@ int main(int argc, char **argv)
         // Code generation - automatically detect required headers and features
         std::set<std::string> required_headers = get_required_headers(all_components);
         FeatureFlags features = detect_features(all_components, required_headers);
+        if (trace.record)
+        {
+            required_headers.insert("storage"); // The recorder saves to localStorage
+        }
+
+        // Release builds use short scope attribute values in both the DOM code and the CSS
+        if (release)
+        {
+            assign_short_css_scopes(all_components);
+        }
+
+        // Route sheets are named before code generation: release names carry a content hash the
+        // generated code refers to
+        std::vector<RouteStylesheet> route_sheets = plan_route_stylesheets(all_components, final_app_config.root_component, release);
 
         // Generate C++ code
         generate_cpp_code(out, all_components, all_global_data, all_global_enums,
-                          final_app_config, required_headers, features);
+                          final_app_config, required_headers, features, route_sheets, debug, trace);
 
         out.close();
         if (keep_cc)
@@ -491,9 +549,10 @@ int main(int argc, char **argv)
 
         if (!cc_only)
         {
-            // Generate CSS file with all styles
+            // Generate CSS file with all styles; route-only component styles get their own sheets
             fs::path css_path = final_output_dir / "app.css";
-            generate_css_file(css_path, input_file, all_components);
+            generate_css_file(css_path, input_file, all_components, route_sheets, release, final_app_config.root_component,
+                              features.kept_branches);
         }
 
         // Run WebCC if not cc-only
@@ -518,8 +577,19 @@ int main(int argc, char **argv)
                     {
                         tmpl_out << "    <meta name=\"description\" content=\"" << final_app_config.description << "\">\n";
                     }
-                    // Auto-include generated CSS using deploy-path-safe relative URL
+                    // Start fetching the runtime and the WASM binary while the HTML is still parsing.
+                    // crossorigin matches the loader's fetch() so the preloaded response is reused.
+                    tmpl_out << "    <link rel=\"preload\" href=\"./app.wasm\" as=\"fetch\" type=\"application/wasm\" crossorigin>\n";
+                    tmpl_out << "    <link rel=\"preload\" href=\"./app.js\" as=\"script\">\n";
+
+                    // Auto-include generated CSS using deploy-path-safe relative URL. It stays render-blocking:
+                    // it holds every non-route component's styles, so the first frame needs all of it.
                     tmpl_out << "    <link rel=\"stylesheet\" href=\"./app.css\">\n";
+                    // Start fetching route sheets with the page; the app attaches them at startup
+                    for (const auto &sheet : route_sheets)
+                    {
+                        tmpl_out << "    <link rel=\"preload\" href=\"./" << sheet.file << "\" as=\"style\">\n";
+                    }
                     tmpl_out << "    <link rel=\"icon\" href=\"data:,\">\n";
                     tmpl_out << "</head>\n";
                     tmpl_out << "<body>\n";
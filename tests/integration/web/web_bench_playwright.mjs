@@ -0,0 +1,107 @@
+#!/usr/bin/env node
+// Runs a bench build (see tests/runner/bench.py) for a number of frames and prints its
+// heap statistics and frame time as JSON on stdout.
+
+function parseSize(s) {
+  const m = String(s || "").trim().match(/^(\d+)x(\d+)$/);
+  if (!m) throw new Error(`invalid --size '${s}' (expected WxH, e.g. 960x540)`);
+  return { width: parseInt(m[1], 10), height: parseInt(m[2], 10) };
+}
+
+function parseArgs(argv) {
+  const out = {
+    url: "",
+    frames: 600,
+    size: "960x540",
+    timeoutMs: 60000,
+    browserPath: "",
+  };
+  for (let i = 2; i < argv.length; i++) {
+    const a = argv[i];
+    if (a === "--url") out.url = argv[++i] || "";
+    else if (a === "--frames") out.frames = parseInt(argv[++i] || "0", 10) || out.frames;
+    else if (a === "--size") out.size = argv[++i] || "";
+    else if (a === "--timeout-ms") out.timeoutMs = parseInt(argv[++i] || "0", 10) || out.timeoutMs;
+    else if (a === "--browser") out.browserPath = argv[++i] || "";
+    else throw new Error(`Unknown argument: ${a}`);
+  }
+  if (!out.url) {
+    throw new Error(
+      "usage: web_bench_playwright.mjs --url <url> [--frames N] [--size WxH] [--timeout-ms N] [--browser <path>]",
+    );
+  }
+  return out;
+}
+
+// #coi-bench text: frames|live|live_bytes|high_water|reserved|fragmentation
+async function readStats(page) {
+  const text = await page.locator("#coi-bench").innerText();
+  const [frames, live, liveBytes, highWater, reserved, fragmentation] = text.trim().split("|").map(Number);
+  return { frames, live, liveBytes, highWater, reserved, fragmentation };
+}
+
+async function main() {
+  const { url, frames, size, timeoutMs, browserPath } = parseArgs(process.argv);
+  const { width, height } = parseSize(size);
+
+  const { chromium } = await import("playwright-core");
+  const browser = await chromium.launch({
+    headless: true,
+    executablePath: browserPath || undefined,
+    args: ["--no-sandbox", "--disable-dev-shm-usage", "--hide-scrollbars", `--window-size=${width},${height}`],
+  });
+
+  const ctx = await browser.newContext({ viewport: { width, height }, deviceScaleFactor: 1 });
+  const page = await ctx.newPage();
+  page.setDefaultTimeout(timeoutMs);
+
+  const consoleErrors = [];
+  page.on("pageerror", (err) => consoleErrors.push(String(err?.stack || err)));
+  page.on("console", (msg) => {
+    if (msg.type() === "error") consoleErrors.push(msg.text());
+  });
+
+  try {
+    await page.goto(url, { waitUntil: "load" });
+    await page.waitForSelector("#coi-bench");
+
+    const start = await readStats(page);
+    const startMs = await page.evaluate(() => performance.now());
+    await page.waitForFunction(
+      (target) => {
+        const el = document.getElementById("coi-bench");
+        return el && Number(el.textContent.split("|")[0]) >= target;
+      },
+      start.frames + frames,
+      { polling: "raf" },
+    );
+    const endMs = await page.evaluate(() => performance.now());
+    const end = await readStats(page);
+
+    if (consoleErrors.length) {
+      throw new Error(`Console errors:\n${consoleErrors.map((s) => `- ${s}`).join("\n")}`);
+    }
+
+    const ran = end.frames - start.frames;
+    process.stdout.write(
+      JSON.stringify({
+        frames: ran,
+        ms_per_frame: (endMs - startMs) / ran,
+        live: end.live,
+        live_bytes: end.liveBytes,
+        high_water: end.highWater,
+        reserved: end.reserved,
+        fragmentation: end.fragmentation,
+      }) + "\n",
+    );
+  } finally {
+    await page.close().catch(() => {});
+    await ctx.close().catch(() => {});
+    await browser.close().catch(() => {});
+  }
+}
+
+await main().catch((err) => {
+  console.error(err?.stack || String(err));
+  process.exit(1);
+});
@@ -11,6 +11,8 @@ sys.path.append(str(Path(__file__).parent))
 from runner.unit import UnitRunner
 from runner.integration import IntegrationRunner
 from runner.gallery import GalleryRunner
+from runner.bench import BenchRunner
+from runner.packages import PackagesRunner
 
 # Paths
 SCRIPT_DIR = Path(__file__).parent.resolve()
@@ -41,6 +43,18 @@ def main():
 
     p_it.add_argument("--headed", action="store_true", help="Run headed")
 
+    # Bench
+    p_bench = subparsers.add_parser("bench", help="Benchmark heap allocators on the bench scenes")
+    p_bench.add_argument("--scene", help="Scene name filter")
+    p_bench.add_argument("--allocator", help="Comma-separated allocators (default: slab,tlsf,bump)")
+    p_bench.add_argument("--frames", type=int, default=600, help="Frames to run each scene for")
+    p_bench.add_argument("--out", help="Output dir", default="tests/integration/web/.cache/bench")
+    p_bench.add_argument("--size", help="Viewport size", default="960x540")
+    p_bench.add_argument("--browser", help="Browser binary path")
+
+    # Packages
+    p_packages = subparsers.add_parser("packages", help="Run package manager tests against local repositories")
+
     # List
     p_list = subparsers.add_parser("list", help="List available scenes")
     p_list.add_argument("--scene", help="Filter scenes")
@@ -76,6 +90,14 @@ def main():
         runner = GalleryRunner(PROJECT_ROOT)
         runner.run(args)
 
+    elif args.command == "bench":
+        runner = BenchRunner(PROJECT_ROOT)
+        runner.run(args)
+
+    elif args.command == "packages":
+        runner = PackagesRunner(PROJECT_ROOT)
+        runner.run(args)
+
     elif args.command == "list":
         # Reuse integration runner to parse manifest
         runner = IntegrationRunner(PROJECT_ROOT)
@@ -0,0 +1,183 @@
+import json
+import re
+import shutil
+import subprocess
+import sys
+from pathlib import Path
+from .base import GREEN, RED, NC
+from .web_base import WebRunnerBase, WebServer
+
+ALLOCATORS = ["slab", "tlsf", "bump"]
+
+# Root of the bench build: renders the scene's root component next to the heap statistics.
+# #coi-bench holds "frames|live|live_bytes|high_water|reserved|fragmentation", which the
+# Playwright script reads once the scene has run for the requested number of frames.
+BENCH_ROOT = """import "{entry}";
+
+component CoiBench {{
+    mut int frames = 0;
+    mut int live = 0;
+    mut int liveBytes = 0;
+    mut int highWater = 0;
+    mut int reserved = 0;
+    mut float fragmentation = 0.0;
+
+    tick(float dt) {{
+        frames += 1;
+        live = Heap.liveAllocations();
+        liveBytes = Heap.liveBytes();
+        highWater = Heap.highWater();
+        reserved = Heap.reservedBytes();
+        fragmentation = Heap.fragmentation();
+    }}
+
+    view {{
+        <div>
+            <{root} />
+            <pre id="coi-bench">{{frames}}|{{live}}|{{liveBytes}}|{{highWater}}|{{reserved}}|{{fragmentation}}</pre>
+        </div>
+    }}
+}}
+
+app {{
+    root = CoiBench;
+    allocator = "{allocator}";
+}}
+"""
+
+APP_BLOCK = re.compile(r"^app\s*\{[^}]*\}", re.MULTILINE)
+APP_ROOT = re.compile(r"\broot\s*=\s*([A-Za-z_][A-Za-z0-9_:]*)\s*;")
+
+
+class BenchRunner(WebRunnerBase):
+    def __init__(self, root_dir):
+        super().__init__(root_dir)
+        self.manifest_path = self.web_dir / "bench_manifest.txt"
+        self.out_dir = self.web_dir / ".cache/bench"
+
+    def project_dir(self, scene_path):
+        # A project keeps its sources in src/; a standalone scene only needs its own folder
+        parent = scene_path.parent
+        return parent.parent if parent.name == "src" else parent
+
+    def prepare(self, scene_path, allocator, work_dir):
+        # Copy the project and move its app block to a bench root that selects the allocator
+        project = self.project_dir(scene_path)
+        if work_dir.exists():
+            shutil.rmtree(work_dir)
+        shutil.copytree(project, work_dir, ignore=shutil.ignore_patterns(".cache", "dist", "build"))
+        entry = work_dir / scene_path.relative_to(project)
+
+        source = entry.read_text()
+        block = APP_BLOCK.search(source)
+        root = APP_ROOT.search(block.group(0)) if block else None
+        if not root:
+            self.fail(f"{scene_path} has no app block with a root component")
+        entry.write_text(source[:block.start()] + source[block.end():])
+
+        bench_entry = entry.parent / "__coi_bench.coi"
+        bench_entry.write_text(BENCH_ROOT.format(entry=entry.name, root=root.group(1), allocator=allocator))
+        return bench_entry
+
+    def run(self, args):
+        self.check_deps()
+        self.ensure_build()
+
+        scenes = self.parse_manifest(args.scene)
+        if not scenes:
+            self.fail("No scenes matched")
+
+        allocators = [a.strip() for a in args.allocator.split(",")] if args.allocator else ALLOCATORS
+        for allocator in allocators:
+            if allocator not in ALLOCATORS:
+                self.fail(f"Unknown allocator '{allocator}' (expected {', '.join(ALLOCATORS)})")
+
+        out_dir = Path(args.out) if args.out else self.out_dir
+        out_dir.mkdir(parents=True, exist_ok=True)
+        browser = self.get_browser(args.browser)
+
+        results = []
+        failed = 0
+        for name, rel_path in scenes:
+            scene_path = self.root_dir / rel_path
+            if not scene_path.exists():
+                print(f"error: missing scene file: {scene_path}")
+                failed += 1
+                continue
+
+            for allocator in allocators:
+                label = f"{name} [{allocator}]"
+                print(f"{label}...", end="", flush=True)
+
+                run_dir = out_dir / name / allocator
+                build_dir = run_dir / "build"
+                bench_entry = self.prepare(scene_path, allocator, run_dir / "project")
+                build_dir.mkdir(parents=True, exist_ok=True)
+
+                try:
+                    subprocess.check_output(
+                        [str(self.compiler_bin), str(bench_entry), "--release", "--out", str(build_dir)],
+                        stderr=subprocess.STDOUT
+                    )
+                except subprocess.CalledProcessError as e:
+                    print(f"\r\033[K{label} {RED}FAIL (Build){NC}")
+                    print(e.output.decode('utf-8'))
+                    failed += 1
+                    continue
+                (build_dir / "favicon.ico").touch()
+
+                with WebServer(build_dir) as url:
+                    cmd = [
+                        "node", str(self.web_dir / "web_bench_playwright.mjs"),
+                        "--url", f"{url}/index.html",
+                        "--frames", str(args.frames),
+                        "--size", args.size,
+                        "--browser", browser
+                    ]
+                    proc = subprocess.run(cmd, capture_output=True)
+                if proc.returncode != 0:
+                    print(f"\r\033[K{label} {RED}FAIL{NC}")
+                    print(proc.stderr.decode('utf-8'))
+                    failed += 1
+                    continue
+
+                stats = json.loads(proc.stdout.decode('utf-8'))
+                stats.update({"scene": name, "allocator": allocator})
+                results.append(stats)
+                print(f"\r\033[K{label} {GREEN}OK{NC}")
+
+        if results:
+            self.print_table(results)
+            results_path = out_dir / "results.json"
+            results_path.write_text(json.dumps(results, indent=2) + "\n")
+            print(f"\nResults written to {results_path}")
+
+        if failed:
+            print(f"\n{RED}{failed} run(s) failed{NC}")
+            sys.exit(1)
+
+    def print_table(self, results):
+        columns = [
+            ("scene", "scene", "{}"),
+            ("allocator", "allocator", "{}"),
+            ("ms/frame", "ms_per_frame", "{:.2f}"),
+            ("live", "live", "{}"),
+            ("live KiB", "live_bytes", "{:.1f}"),
+            ("high water KiB", "high_water", "{:.1f}"),
+            ("reserved KiB", "reserved", "{:.1f}"),
+            ("fragmentation", "fragmentation", "{:.1%}"),
+        ]
+        rows = []
+        for r in results:
+            row = []
+            for _, key, fmt in columns:
+                value = r[key]
+                if key in ("live_bytes", "high_water", "reserved"):
+                    value = value / 1024
+                row.append(fmt.format(value))
+            rows.append(row)
+        widths = [max(len(title), *(len(row[i]) for row in rows)) for i, (title, _, _) in enumerate(columns)]
+        print()
+        print("  ".join(title.ljust(widths[i]) for i, (title, _, _) in enumerate(columns)))
+        for row in rows:
+            print("  ".join(cell.ljust(widths[i]) for i, cell in enumerate(row)))
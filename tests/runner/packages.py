@@ -0,0 +1,272 @@
+import hashlib
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import threading
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from pathlib import Path
+from .base import TestRunnerBase, GREEN, RED, NC
+
+
+def tree_hash(root):
+    # Same digest as: find . -path ./.git -prune -o -type f -print0 | sort -z | xargs -0 sha256sum | sha256sum
+    files = []
+    for dirpath, dirnames, filenames in os.walk(root):
+        if Path(dirpath) == Path(root):
+            dirnames[:] = [d for d in dirnames if d != ".git"]
+        for name in filenames:
+            files.append("./" + (Path(dirpath) / name).relative_to(root).as_posix())
+    manifest = ""
+    for rel in sorted(files, key=lambda f: f.encode()):
+        digest = hashlib.sha256((Path(root) / rel).read_bytes()).hexdigest()
+        manifest += f"{digest}  {rel}\n"
+    return hashlib.sha256(manifest.encode()).hexdigest()
+
+
+class RegistryServer:
+    """Serves a registry directory over HTTP with ETags, answering If-None-Match with 304."""
+
+    def __init__(self, directory):
+        self.directory = Path(directory)
+        self.requests = []
+
+    def __enter__(self):
+        server = self
+
+        class Handler(BaseHTTPRequestHandler):
+            def do_GET(self):
+                path = server.directory / self.path.lstrip("/")
+                if not path.is_file():
+                    server.requests.append((self.path, self.headers.get("If-None-Match"), 404))
+                    self.send_error(404)
+                    return
+                body = path.read_bytes()
+                etag = '"' + hashlib.sha256(body).hexdigest()[:16] + '"'
+                status = 304 if self.headers.get("If-None-Match") == etag else 200
+                server.requests.append((self.path, self.headers.get("If-None-Match"), status))
+                self.send_response(status)
+                self.send_header("ETag", etag)
+                if status == 200:
+                    self.send_header("Content-Length", str(len(body)))
+                self.end_headers()
+                if status == 200:
+                    self.wfile.write(body)
+
+            def log_message(self, format, *args):
+                pass
+
+        self.httpd = ThreadingHTTPServer(("127.0.0.1", 0), Handler)
+        self.thread = threading.Thread(target=self.httpd.serve_forever, daemon=True)
+        self.thread.start()
+        self.url = f"http://127.0.0.1:{self.httpd.server_address[1]}/"
+        return self
+
+    def __exit__(self, *exc):
+        self.httpd.shutdown()
+        self.httpd.server_close()
+
+
+class PackagesRunner(TestRunnerBase):
+    """Runs the package manager against local bare repositories and a registry directory."""
+
+    def run(self, args):
+        self.ensure_build()
+        self.work = Path(tempfile.mkdtemp(prefix="coi-packages-"))
+        self.failures = []
+        self.total = 0
+        try:
+            self.pond = self.compiler_pond()
+            self.registry = self.work / "registry"
+            self.env = dict(os.environ)
+            self.env.update({
+                "HOME": str(self.work / "home"),
+                "COI_STORE": str(self.work / "store"),
+                "COI_CACHE": str(self.work / "cache"),
+                "COI_REGISTRY": self.registry.as_uri() + "/",
+            })
+            self.test_parallel_install()
+            self.test_hash_mismatch_warns()
+            self.test_file_registry_cache()
+            self.test_etag_revalidation()
+            self.test_offline()
+            self.test_malformed_entry()
+        finally:
+            shutil.rmtree(self.work, ignore_errors=True)
+
+        if not self.failures:
+            print(f"{GREEN}All {self.total} package tests passed!{NC}")
+        else:
+            print(f"{RED}{len(self.failures)} package test(s) failed:{NC}")
+            for msg in self.failures:
+                print(f"  {RED}✗{NC} {msg}")
+            sys.exit(1)
+
+    def check(self, name, ok, detail=""):
+        self.total += 1
+        if ok:
+            print(f"  {GREEN}✓{NC} {name}")
+        else:
+            print(f"  {RED}✗{NC} {name}")
+            self.failures.append(f"{name}{': ' + detail if detail else ''}")
+
+    def compiler_pond(self):
+        out = subprocess.run([str(self.compiler_bin), "version"], capture_output=True, text=True).stdout
+        match = re.search(r"Pond (\d+)", re.sub(r"\x1b\[[0-9;]*m", "", out))
+        return int(match.group(1)) if match else 0
+
+    def coi(self, project, *args):
+        project.mkdir(parents=True, exist_ok=True)
+        return subprocess.run([str(self.compiler_bin), *args], cwd=project, env=self.env,
+                              capture_output=True, text=True)
+
+    def make_package(self, name, files):
+        # A bare repository holding one commit with the given files
+        src = self.work / "src" / name
+        src.mkdir(parents=True)
+        for rel, content in files.items():
+            (src / rel).parent.mkdir(parents=True, exist_ok=True)
+            (src / rel).write_text(content)
+        git = ["git", "-c", "user.name=coi", "-c", "user.email=coi@localhost"]
+        subprocess.check_call(git + ["init", "-q"], cwd=src)
+        subprocess.check_call(git + ["add", "-A"], cwd=src)
+        subprocess.check_call(git + ["commit", "-q", "-m", "release"], cwd=src)
+        commit = subprocess.check_output(["git", "rev-parse", "HEAD"], cwd=src, text=True).strip()
+        bare = self.work / "repos" / f"{name}.git"
+        subprocess.check_call(["git", "clone", "-q", "--bare", str(src), str(bare)])
+        return bare, commit, tree_hash(src)
+
+    def publish(self, scope, name, bare, commit, sha256):
+        doc = {
+            "name": f"{scope}/{name}",
+            "repository": str(bare),
+            "releases": [{
+                "version": "1.0.0",
+                "compiler": {"pond": self.pond, "min-drop": 0},
+                "source": {"commit": commit, "sha256": sha256},
+            }],
+        }
+        path = self.registry / scope / f"{name}.json"
+        path.parent.mkdir(parents=True, exist_ok=True)
+        path.write_text(json.dumps(doc, indent=2))
+
+    def test_parallel_install(self):
+        print("install from coi.lock")
+        names = ["alpha", "beta", "gamma", "delta"]
+        hashes = {}
+        for i, name in enumerate(names):
+            files = {"Mod.coi": f"// {name}\n", "src/Widget.coi": "component Widget {}\n" * (i + 1)}
+            bare, commit, sha = self.make_package(name, files)
+            self.publish("test", name, bare, commit, sha)
+            hashes[name] = sha
+
+        project = self.work / "install"
+        for name in names:
+            result = self.coi(project, "add", f"@test/{name}")
+            self.check(f"add @test/{name}", result.returncode == 0, result.stderr.strip())
+
+        shutil.rmtree(project / ".coi", ignore_errors=True)
+        result = self.coi(project, "install")
+        self.check("install runs all packages on the worker pool",
+                   result.returncode == 0 and "parallel" in result.stdout, result.stdout + result.stderr)
+        for name in names:
+            pkg = project / ".coi" / "pkgs" / "test" / name
+            self.check(f"@test/{name} installed with its files", (pkg / "Mod.coi").exists() and (pkg / "src/Widget.coi").exists())
+            self.check(f"@test/{name} tree hash matches the pipeline", tree_hash(pkg) == hashes[name])
+            self.check(f"@test/{name} published to the store", (self.work / "store" / hashes[name] / "Mod.coi").exists())
+
+    def test_hash_mismatch_warns(self):
+        print("hash mismatch")
+        bare, commit, _ = self.make_package("tarball", {"Mod.coi": "// tarball\n"})
+        tarball_hash = hashlib.sha256(b"not the tree").hexdigest()
+        self.publish("test", "tarball", bare, commit, tarball_hash)
+
+        project = self.work / "mismatch"
+        result = self.coi(project, "add", "@test/tarball")
+        self.check("a mismatching tree hash still installs", result.returncode == 0, result.stderr.strip())
+        self.check("a mismatching tree hash warns", "does not match source.sha256" in result.stderr)
+        self.check("the package is in the project", (project / ".coi/pkgs/test/tarball/Mod.coi").exists())
+        self.check("an unverified checkout is kept out of the store", not (self.work / "store" / tarball_hash).exists())
+
+    def test_file_registry_cache(self):
+        print("registry cache")
+        project = self.work / "cache-file"
+        result = self.coi(project, "add", "@test/alpha")
+        doc = self.work / "cache" / "test" / "alpha.json"
+        meta = self.work / "cache" / "test" / "alpha.meta"
+        self.check("a file:// registry resolves", result.returncode == 0, result.stderr.strip())
+        self.check("the index document is cached", doc.exists() and json.loads(doc.read_text())["name"] == "test/alpha")
+        self.check("the cache records where the document came from",
+                   meta.exists() and f"url {self.env['COI_REGISTRY']}test/alpha.json" in meta.read_text())
+
+    def test_etag_revalidation(self):
+        print("ETag revalidation")
+        bare, commit, sha = self.make_package("etag", {"Mod.coi": "// etag\n"})
+        self.publish("test", "etag", bare, commit, sha)
+        saved = self.env
+        with RegistryServer(self.registry) as server:
+            self.env = dict(saved, COI_REGISTRY=server.url, COI_CACHE=str(self.work / "cache-http"))
+            requests = lambda: [r for r in server.requests if r[0] == "/test/etag.json"]
+
+            first = self.coi(self.work / "etag-1", "add", "@test/etag")
+            self.check("the first add downloads the index", first.returncode == 0 and requests() == [("/test/etag.json", None, 200)],
+                       f"{requests()} {first.stderr.strip()}")
+            meta = self.work / "cache-http" / "test" / "etag.meta"
+            self.check("the ETag is cached", meta.exists() and "etag \"" in meta.read_text())
+
+            del server.requests[:]
+            second = self.coi(self.work / "etag-2", "add", "@test/etag")
+            sent = requests()
+            self.check("the next add sends If-None-Match", len(sent) == 1 and sent[0][1] is not None, str(sent))
+            self.check("a 304 is served from the cache", second.returncode == 0 and sent and sent[0][2] == 304,
+                       f"{sent} {second.stderr.strip()}")
+
+            # A changed document gets a new ETag, so the conditional request downloads it again
+            doc = self.registry / "test" / "etag.json"
+            entry = json.loads(doc.read_text())
+            entry["releases"][0]["version"] = "1.0.1"
+            doc.write_text(json.dumps(entry, indent=2))
+            del server.requests[:]
+            third = self.coi(self.work / "etag-3", "add", "@test/etag")
+            cached = self.work / "cache-http" / "test" / "etag.json"
+            self.check("a changed document is downloaded again", third.returncode == 0 and requests()[0][2] == 200,
+                       f"{requests()} {third.stderr.strip()}")
+            self.check("the cache holds the new document", '"1.0.1"' in cached.read_text())
+        self.env = saved
+
+    def test_offline(self):
+        print("offline")
+        unreachable = dict(self.env, COI_REGISTRY="http://127.0.0.1:9/")
+        saved, self.env = self.env, unreachable
+        try:
+            result = self.coi(self.work / "offline", "add", "@test/alpha", "--offline")
+            self.check("--offline resolves a cached package without the registry", result.returncode == 0, result.stderr.strip())
+            self.check("--offline installs the package", (self.work / "offline/.coi/pkgs/test/alpha/Mod.coi").exists())
+
+            result = self.coi(self.work / "offline-miss", "add", "@test/missing", "--offline")
+            self.check("--offline fails for an uncached package",
+                       result.returncode != 0 and "is not in the registry cache" in result.stderr, result.stderr.strip())
+
+            result = self.coi(self.work / "unreachable", "add", "@test/alpha")
+            self.check("an unreachable registry falls back to the cache",
+                       result.returncode == 0 and "Registry unreachable" in result.stderr, result.stderr.strip())
+        finally:
+            self.env = saved
+
+    def test_malformed_entry(self):
+        print("malformed entries")
+        cases = {
+            "broken": '{"name": "test/broken", "repository": ',
+            "trailing": '{"name": "test/trailing", "repository": "x", "releases": []} }',
+            "notobject": '["test/notobject"]',
+        }
+        for name, text in cases.items():
+            path = self.registry / "test" / f"{name}.json"
+            path.write_text(text)
+            result = self.coi(self.work / f"malformed-{name}", "add", f"@test/{name}")
+            self.check(f"{name} JSON is rejected",
+                       result.returncode != 0 and f"Malformed registry entry for 'test/{name}'" in result.stderr,
+                       result.stderr.strip())